@@ -1,7 +1,9 @@
 #include "GameController.hpp"
 
 #include "../logic/Board.hpp"
+#include "../logic/MoveGen.hpp"
 #include "../logic/Piece.hpp"
+#include "../logic/Rules.hpp"
 
 #include <algorithm>
 
@@ -21,388 +23,6 @@ static GameController::Player opposite(GameController::Player p)
            : GameController::Player::White;
 }
 
-// Проверка: фигура p с клетки (pr,pc) атакует ли клетку (tr,tc)?
-// Используем реальные шаблоны ходов Omega Chess (король, ферзь, ладья, слон, конь, пешка,
-// чемпион, волшебник). Для пешек учитываем только шаблон взятия.
-static bool pieceAttacksSquare(const Board &board,
-                               const Piece &p,
-                               int pr, int pc,
-                               int tr, int tc)
-{
-    if (p.isEmpty())
-        return false;
-
-    const int dr = tr - pr;
-    const int dc = tc - pc;
-
-    auto sameSign = [](int x, int y) {
-        return (x == 0 || y == 0) ? false : ( (x > 0) == (y > 0) );
-    };
-
-    // ---------------- ПЕШКА ----------------
-    if (p.kind == PieceKind::Pawn)
-    {
-        if (p.color == PieceColor::White)
-        {
-            // Белые бьют вверх (в сторону меньших row)
-            return (dr == -1 && (dc == -1 || dc == 1));
-        }
-        else if (p.color == PieceColor::Black)
-        {
-            // Чёрные бьют вниз (в сторону больших row)
-            return (dr == 1 && (dc == -1 || dc == 1));
-        }
-        return false;
-    }
-
-    // ---------------- КОНЬ ----------------
-    if (p.kind == PieceKind::Knight)
-    {
-        const int adr = std::abs(dr);
-        const int adc = std::abs(dc);
-        return (adr == 1 && adc == 2) || (adr == 2 && adc == 1);
-    }
-
-    // ---------------- КОРОЛЬ ----------------
-    if (p.kind == PieceKind::King)
-    {
-        return std::max(std::abs(dr), std::abs(dc)) == 1;
-    }
-
-    // ---------------- ЛАДЬЯ / ФЕРЗЬ (по прямым) ----------------
-    auto rookLikeAttacks = [&](void) -> bool
-    {
-        if (dr != 0 && dc != 0)
-            return false;
-
-        int stepR = (dr == 0) ? 0 : (dr > 0 ? 1 : -1);
-        int stepC = (dc == 0) ? 0 : (dc > 0 ? 1 : -1);
-
-        int r = pr + stepR;
-        int c = pc + stepC;
-        while (board.isInsideArray(r, c) && board.isValidCell(r, c))
-        {
-            if (r == tr && c == tc)
-                return true;
-
-            if (!board.isEmpty(r, c))
-                break;
-
-            r += stepR;
-            c += stepC;
-        }
-        return false;
-    };
-
-    // ---------------- СЛОН / ФЕРЗЬ (по диагоналям) ----------------
-    auto bishopLikeAttacks = [&](void) -> bool
-    {
-        if (std::abs(dr) != std::abs(dc) || dr == 0)
-            return false;
-
-        int stepR = (dr > 0 ? 1 : -1);
-        int stepC = (dc > 0 ? 1 : -1);
-
-        int r = pr + stepR;
-        int c = pc + stepC;
-        while (board.isInsideArray(r, c) && board.isValidCell(r, c))
-        {
-            if (r == tr && c == tc)
-                return true;
-
-            if (!board.isEmpty(r, c))
-                break;
-
-            r += stepR;
-            c += stepC;
-        }
-        return false;
-    };
-
-    // ---------------- CHAMPION ----------------
-    // Champion: может прыгать на 2 клетки по прямым или диагоналям, либо
-    // шагнуть на 1 клетку по прямой (WAD в Betza нотации).
-    if (p.kind == PieceKind::Champion)
-    {
-        const int adr = std::abs(dr);
-        const int adc = std::abs(dc);
-
-        // Одноклеточный ход по вертикали/горизонтали
-        if ((adr == 1 && adc == 0) || (adr == 0 && adc == 1))
-            return true;
-
-        // Двухклеточный прыжок по вертикали/горизонтали
-        if ((adr == 2 && adc == 0) || (adr == 0 && adc == 2))
-            return true;
-
-        // Двухклеточный прыжок по диагонали
-        if (adr == 2 && adc == 2)
-            return true;
-
-        return false;
-    }
-
-    // ---------------- WIZARD ----------------
-    // Wizard: может ходить на 1 по диагонали, либо «растянутый конь»:
-    // (1,3) или (3,1) в любом направлении. Все ходы — прыжки.
-    if (p.kind == PieceKind::Wizard)
-    {
-        const int adr = std::abs(dr);
-        const int adc = std::abs(dc);
-
-        // Один шаг по диагонали
-        if (adr == 1 && adc == 1)
-            return true;
-
-        // «верблюдовый» скачок 1x3
-        if ((adr == 1 && adc == 3) || (adr == 3 && adc == 1))
-            return true;
-
-        return false;
-    }
-
-    // ---------------- ЛАДЬЯ ----------------
-    if (p.kind == PieceKind::Rook)
-    {
-        return rookLikeAttacks();
-    }
-
-    // ---------------- СЛОН ----------------
-    if (p.kind == PieceKind::Bishop)
-    {
-        return bishopLikeAttacks();
-    }
-
-    // ---------------- ФЕРЗЬ ----------------
-    if (p.kind == PieceKind::Queen)
-    {
-        return rookLikeAttacks() || bishopLikeAttacks();
-    }
-
-    return false;
-}
-
-// Проверка: может ли фигура p с клетки (fr,fc) пойти на (tr,tc)
-// с учётом типа хода (взятие / не взятие).
-// Здесь мы проверяем только "псевдолегальность":
-//  - шаблон хода по типу фигуры,
-//  - отсутствие фигур на пути для скользящих фигур (это уже делает pieceAttacksSquare).
-// Проверка шаха/само-шаха выполняется отдельно.
-static bool pieceCanMove(const Board &board,
-                         const Piece &p,
-                         int fr, int fc,
-                         int tr, int tc,
-                         bool isCapture)
-{
-    if (p.isEmpty())
-        return false;
-
-    if (fr == tr && fc == tc)
-        return false;
-
-    const int dr = tr - fr;
-    const int dc = tc - fc;
-
-    // --- Пешка ---
-    if (p.kind == PieceKind::Pawn)
-    {
-        // Взятие пешкой: как в шахматах (на одну диагональ вперёд)
-        if (isCapture)
-        {
-            return pieceAttacksSquare(board, p, fr, fc, tr, tc);
-        }
-        else
-        {
-            // Тихий ход: только вперёд по вертикали
-            if (dc != 0)
-                return false;
-
-            const int WHITE_PAWN_START_ROW = 9;  // белые пешки стоят на 9-й горизонтали
-            const int BLACK_PAWN_START_ROW = 2;  // чёрные пешки стоят на 2-й горизонтали
-
-            if (p.color == PieceColor::White)
-            {
-                // Белые идут вверх (уменьшение row)
-                if (dr >= 0) // не вперёд
-                    return false;
-
-                const int steps = -dr; // 1,2,3
-
-                // После первого хода — только по 1
-                if (p.hasMoved)
-                {
-                    if (steps != 1)
-                        return false;
-                }
-                else
-                {
-                    // Первый ход: только с начальной горизонтали и на 1..3 клетки
-                    if (fr != WHITE_PAWN_START_ROW)
-                        return false;
-
-                    if (steps < 1 || steps > 3)
-                        return false;
-                }
-
-                // Проверяем, что все клетки по пути пусты
-                for (int k = 1; k <= -dr; ++k)
-                {
-                    const int r = fr - k;
-                    if (!board.isInsideArray(r, fc) || !board.isValidCell(r, fc))
-                        return false;
-                    if (!board.isEmpty(r, fc))
-                        return false;
-                }
-
-                return true;
-            }
-            else if (p.color == PieceColor::Black)
-            {
-                // Чёрные идут вниз (увеличение row)
-                if (dr <= 0)
-                    return false;
-
-                const int steps = dr; // 1,2,3
-
-                if (p.hasMoved)
-                {
-                    if (steps != 1)
-                        return false;
-                }
-                else
-                {
-                    if (fr != BLACK_PAWN_START_ROW)
-                        return false;
-
-                    if (steps < 1 || steps > 3)
-                        return false;
-                }
-
-                for (int k = 1; k <= dr; ++k)
-                {
-                    const int r = fr + k;
-                    if (!board.isInsideArray(r, fc) || !board.isValidCell(r, fc))
-                        return false;
-                    if (!board.isEmpty(r, fc))
-                        return false;
-                }
-
-                return true;
-            }
-
-            return false;
-        }
-    }
-
-    // --- Конь ---
-    if (p.kind == PieceKind::Knight)
-    {
-        const int adr = std::abs(dr);
-        const int adc = std::abs(dc);
-        return (adr == 1 && adc == 2) || (adr == 2 && adc == 1);
-    }
-
-    // --- Король (обычные ходы, без рокировки) ---
-    if (p.kind == PieceKind::King)
-    {
-        return std::max(std::abs(dr), std::abs(dc)) == 1;
-    }
-
-    // --- Вспомогательные лямбды для ладьи/слона/ферзя ---
-    auto rookLikeAttacks = [&](void) -> bool
-    {
-        if (dr != 0 && dc != 0)
-            return false;
-
-        int stepR = (dr == 0) ? 0 : (dr > 0 ? 1 : -1);
-        int stepC = (dc == 0) ? 0 : (dc > 0 ? 1 : -1);
-
-        int r = fr + stepR;
-        int c = fc + stepC;
-        while (board.isInsideArray(r, c) && board.isValidCell(r, c))
-        {
-            if (r == tr && c == tc)
-                return true;
-
-            if (!board.isEmpty(r, c))
-                break;
-
-            r += stepR;
-            c += stepC;
-        }
-        return false;
-    };
-
-    auto bishopLikeAttacks = [&](void) -> bool
-    {
-        if (std::abs(dr) != std::abs(dc) || dr == 0)
-            return false;
-
-        int stepR = (dr > 0 ? 1 : -1);
-        int stepC = (dc > 0 ? 1 : -1);
-
-        int r = fr + stepR;
-        int c = fc + stepC;
-        while (board.isInsideArray(r, c) && board.isValidCell(r, c))
-        {
-            if (r == tr && c == tc)
-                return true;
-
-            if (!board.isEmpty(r, c))
-                break;
-
-            r += stepR;
-            c += stepC;
-        }
-        return false;
-    };
-
-    // --- Champion ---
-    if (p.kind == PieceKind::Champion)
-    {
-        const int adr = std::abs(dr);
-        const int adc = std::abs(dc);
-
-        if ((adr == 1 && adc == 0) || (adr == 0 && adc == 1))
-            return true; // шаг по ортогонали
-
-        if ((adr == 2 && adc == 0) || (adr == 0 && adc == 2))
-            return true; // прыжок по ортогонали
-
-        if (adr == 2 && adc == 2)
-            return true; // прыжок по диагонали
-
-        return false;
-    }
-
-    // --- Wizard ---
-    if (p.kind == PieceKind::Wizard)
-    {
-        const int adr = std::abs(dr);
-        const int adc = std::abs(dc);
-
-        if (adr == 1 && adc == 1)
-            return true; // шаг по диагонали
-
-        if ((adr == 1 && adc == 3) || (adr == 3 && adc == 1))
-            return true; // "верблюдовый" прыжок
-
-        return false;
-    }
-
-    // --- Ладья / слон / ферзь ---
-    if (p.kind == PieceKind::Rook)
-        return rookLikeAttacks();
-
-    if (p.kind == PieceKind::Bishop)
-        return bishopLikeAttacks();
-
-    if (p.kind == PieceKind::Queen)
-        return rookLikeAttacks() || bishopLikeAttacks();
-
-    return false;
-}
-
 // ---------------------------------------------------------------------
 // Конструктор / деструктор
 // ---------------------------------------------------------------------
@@ -439,6 +59,8 @@ void GameController::startNewGame()
 
     m_history.clear();
     m_historyIndex = 0;
+    resetPositions();
+    m_search.tt().clear();
 
     emit boardChanged();
     emit currentPlayerChanged(m_currentPlayer);
@@ -455,9 +77,16 @@ void GameController::resetToInitialPosition()
     m_currentPlayer = Player::White;
     m_gameState     = GameState::Running;
 
+    // Записи отката относятся к прежней позиции — история больше не применима
+    m_history.clear();
+    m_historyIndex = 0;
+    resetPositions();
+    m_search.tt().clear();
+
     emit boardChanged();
     emit currentPlayerChanged(m_currentPlayer);
     emit gameStateChanged(m_gameState);
+    notifyHistoryChanged();
 }
 
 bool GameController::makeMove(const Position &from, const Position &to)
@@ -470,22 +99,24 @@ bool GameController::makeMove(const Position &from, const Position &to)
 
 bool GameController::makeMove(const Move &move)
 {
-    if (!m_board)
+    if (!m_board || isGameOver())
         return false;
 
-    // Сохраняем состояние доски перед попыткой хода
-    Board  oldBoard       = *m_board;
-    Player movingSide     = m_currentPlayer;
+    const Player movingSide = m_currentPlayer;
 
-    // Пробуем применить ход к доске (проверка границ, своих/чужих фигур и т.п.)
-    if (!applyMoveOnBoard(move))
+    // Проверка хода по правилам (границы, свои/чужие фигуры, рокировка и т.п.)
+    PackedMove packed;
+    if (!Rules::decodeMove(*m_board, move, packed))
         return false;
 
-    // НОВОЕ: ход не должен оставлять собственного короля под ударом
+    UndoInfo undo;
+    m_board->makeMove(packed, undo);
+
+    // Ход не должен оставлять собственного короля под ударом
     if (isKingInCheck(movingSide))
     {
-        // Откат доски
-        *m_board = oldBoard;
+        // Откат доски за O(1)
+        m_board->unmakeMove(packed, undo);
         return false;
     }
 
@@ -496,13 +127,14 @@ bool GameController::makeMove(const Move &move)
                         m_history.end());
     }
 
-    m_history.push_back(move);
+    m_history.push_back(HistoryEntry{move, packed, undo});
     ++m_historyIndex;
+    pushPosition();
 
     // Переход хода к сопернику
     switchPlayer();
 
-    // Обновляем состояние игры (проверяем, не находится ли теперь соперник под шахом)
+    // Обновляем состояние игры (шах, мат или пат сопернику)
     updateGameState();
 
     emit moveMade(move);
@@ -534,196 +166,175 @@ bool GameController::canUndo() const noexcept
     return m_historyIndex > 0;
 }
 
+bool GameController::isGameOver() const noexcept
+{
+    return m_gameState != GameState::Running && m_gameState != GameState::Check;
+}
+
+int GameController::repetitionCount() const noexcept
+{
+    if (m_positions.empty())
+        return 0;
+
+    // Та же сторона хода — через полуход; раньше последнего взятия или
+    // хода пешки позиции повториться не могут
+    const PositionRecord &current = m_positions.back();
+    const std::size_t     last    = m_positions.size() - 1;
+    const std::size_t     reach   = std::min<std::size_t>(last, static_cast<std::size_t>(current.halfmoveClock));
+
+    int count = 1;
+    for (std::size_t back = 2; back <= reach; back += 2)
+    {
+        if (m_positions[last - back].key == current.key)
+            ++count;
+    }
+    return count;
+}
+
 bool GameController::canRedo() const noexcept
 {
     return m_historyIndex < m_history.size();
 }
 
 // ---------------------------------------------------------------------
-// Undo / Redo
+// Движок
 // ---------------------------------------------------------------------
 
-void GameController::undo()
+SearchResult GameController::analyze(const SearchLimits &limits)
 {
-    if (!m_board || !canUndo())
-        return;
+    if (!m_board)
+        return SearchResult();
 
-    // Один шаг назад
-    --m_historyIndex;
+    // Позиции партии до текущей — чтобы поиск видел повторения
+    std::vector<std::uint64_t> keys;
+    keys.reserve(m_positions.size());
+    for (std::size_t i = 0; i + 1 < m_positions.size(); ++i)
+        keys.push_back(m_positions[i].key);
+    m_search.setHistory(keys);
 
-    // Восстанавливаем позицию: с нуля применяем первые m_historyIndex ходов
-    m_board->resetToInitialPosition();
-    m_currentPlayer = Player::White;
+    m_search.prepare();
+    return m_search.search(*m_board, limits);
+}
 
-    for (std::size_t i = 0; i < m_historyIndex; ++i)
-    {
-        const Move &mv = m_history[i];
-        applyMoveOnBoard(mv);
-        switchPlayer();
-    }
+bool GameController::makeEngineMove(const SearchLimits &limits)
+{
+    // Из книги — без поиска
+    const PackedMove book = bookMove();
+    if (!book.isNone())
+        return makeMove(book.toMove());
 
-    updateGameState();
+    const SearchResult result = analyze(limits);
+    if (result.bestMove.isNone())
+        return false;
 
-    emit boardChanged();
-    notifyHistoryChanged();
-    emit currentPlayerChanged(m_currentPlayer);
+    return makeMove(result.bestMove.toMove());
 }
 
-void GameController::redo()
+void GameController::stopAnalysis() noexcept
 {
-    if (!m_board || !canRedo())
-        return;
+    m_search.stop();
+}
 
-    const Move &mv = m_history[m_historyIndex];
+void GameController::setHashSizeMb(std::size_t megabytes)
+{
+    m_search.tt().resize(megabytes);
+}
 
-    if (!applyMoveOnBoard(mv))
-    {
-        return;
-    }
+void GameController::setSearchThreads(int threads)
+{
+    m_search.setThreadCount(threads);
+}
 
-    ++m_historyIndex;
-    switchPlayer();
-    updateGameState();
+bool GameController::loadNetwork(const std::string &path)
+{
+    Nnue::Network network;
+    if (!network.load(path))
+        return false;
 
-    emit moveMade(mv);
-    emit boardChanged();
-    notifyHistoryChanged();
-    emit currentPlayerChanged(m_currentPlayer);
+    m_search.setNetwork(nullptr);
+    m_network = std::move(network);
+    m_search.setNetwork(&m_network);
+
+    // Оценки в таблице посчитаны прежней функцией
+    m_search.tt().clear();
+    return true;
 }
 
 // ---------------------------------------------------------------------
-// Низкоуровневое применение хода
+// Дебютная книга
 // ---------------------------------------------------------------------
 
-bool GameController::applyMoveOnBoard(const Move &move)
+bool GameController::loadOpeningBook(const std::string &path)
 {
-    if (!m_board)
-        return false;
-
-    Board &board = *m_board;
-
-    const int fromRow = move.from.row;
-    const int fromCol = move.from.col;
-    const int toRow   = move.to.row;
-    const int toCol   = move.to.col;
-
-    if (!board.isInsideArray(fromRow, fromCol) ||
-        !board.isInsideArray(toRow, toCol))
+    if (path.empty())
     {
-        return false;
+        m_book.close();
+        return true;
     }
+    return m_book.open(path);
+}
 
-    if (!board.isValidCell(fromRow, fromCol) ||
-        !board.isValidCell(toRow, toCol))
-    {
-        return false;
-    }
+bool GameController::hasOpeningBook() const noexcept
+{
+    return m_book.isOpen();
+}
 
-    Piece fromPiece = board.pieceAt(fromRow, fromCol);
-    if (fromPiece.isEmpty())
-    {
-        return false;
-    }
+std::vector<Db::BookEntry> GameController::bookMoves() const
+{
+    if (!m_board || !m_book.isOpen() || isGameOver())
+        return {};
+    return m_book.entries(*m_board);
+}
 
-    // Ходим только своей фигурой
-    if ((m_currentPlayer == Player::White && fromPiece.color != PieceColor::White) ||
-        (m_currentPlayer == Player::Black && fromPiece.color != PieceColor::Black))
-    {
-        return false;
-    }
+PackedMove GameController::bookMove()
+{
+    if (!m_board || !m_book.isOpen() || isGameOver())
+        return PackedMove();
+    return m_book.pick(*m_board, m_bookRandom());
+}
 
-    Piece toPiece = board.pieceAt(toRow, toCol);
+// ---------------------------------------------------------------------
+// Undo / Redo
+// ---------------------------------------------------------------------
 
-    // Нельзя бить свою фигуру
-    if (!toPiece.isEmpty() && toPiece.color == fromPiece.color)
-    {
-        return false;
-    }
+void GameController::undo()
+{
+    if (!m_board || !canUndo())
+        return;
 
-    const bool isCapture = !toPiece.isEmpty();
+    // Один шаг назад: откат по сохранённой записи, без переигрывания партии
+    --m_historyIndex;
 
-    // Нельзя "снимать" короля противника
-    if (isCapture && toPiece.kind == PieceKind::King)
-    {
-        return false;
-    }
+    const HistoryEntry &entry = m_history[m_historyIndex];
+    m_board->unmakeMove(entry.packed, entry.undo);
+    m_positions.pop_back();
+    switchPlayer();
 
-    // --- Специальный случай: рокировка ---
-    if (fromPiece.kind == PieceKind::King &&
-        !fromPiece.hasMoved &&
-        fromRow == toRow &&
-        !isCapture &&
-        std::abs(toCol - fromCol) == 2)
-    {
-        const int dir = (toCol > fromCol) ? 1 : -1;      // +1: рокировка на "королевский" фланг, -1: на "ферзевый"
-        const int midCol = fromCol + dir;
-
-        // Ищем ладью в нужную сторону: первая фигура на линии должна быть ладьёй того же цвета, ещё не ходившей
-        int rookCol = -1;
-        int c = fromCol + dir;
-        while (board.isInsideArray(fromRow, c) && board.isValidCell(fromRow, c))
-        {
-            if (!board.isEmpty(fromRow, c))
-            {
-                Piece rp = board.pieceAt(fromRow, c);
-                if (rp.kind == PieceKind::Rook &&
-                    rp.color == fromPiece.color &&
-                    !rp.hasMoved)
-                {
-                    rookCol = c;
-                }
-                break; // встретили первую фигуру на пути — дальше искать нельзя
-            }
-            c += dir;
-        }
-
-        if (rookCol == -1)
-        {
-            return false; // ладья не найдена или между королём и ладьёй стоит другая фигура
-        }
-
-        // Должен быть именно ход короля на две клетки к ладье
-        if ((toCol - fromCol) != 2 * dir)
-        {
-            return false;
-        }
-
-        // Проверка атакованных полей: исходное, промежуточное и конечное поле короля не должны быть под боем
-        Player enemy = opposite(m_currentPlayer);
-        if (isSquareAttacked(fromRow, fromCol, enemy) ||
-            isSquareAttacked(fromRow, midCol, enemy)  ||
-            isSquareAttacked(fromRow, toCol,  enemy))
-        {
-            return false;
-        }
-
-        // Выполняем рокировку:
-        // 1) переносим короля
-        board.clearCell(fromRow, fromCol);
-        fromPiece.hasMoved = true;
-        board.setPieceAt(toRow, toCol, fromPiece);
-
-        // 2) переносим ладью рядом с королём
-        Piece rookPiece = board.pieceAt(fromRow, rookCol);
-        board.clearCell(fromRow, rookCol);
-        rookPiece.hasMoved = true;
-        const int rookDestCol = toCol - dir;  // король и ладья оказываются рядом
-        board.setPieceAt(fromRow, rookDestCol, rookPiece);
+    updateGameState();
 
-        return true;
-    }
+    emit boardChanged();
+    notifyHistoryChanged();
+    emit currentPlayerChanged(m_currentPlayer);
+}
 
-    // --- Обычный ход (не рокировка) ---
-    if (!pieceCanMove(board, fromPiece, fromRow, fromCol, toRow, toCol, isCapture))
-    {
-        return false;
-    }
+void GameController::redo()
+{
+    if (!m_board || !canRedo())
+        return;
 
-    fromPiece.hasMoved = true;
-    board.setPieceAt(toRow, toCol, fromPiece);
-    board.clearCell(fromRow, fromCol);
+    HistoryEntry &entry = m_history[m_historyIndex];
+    m_board->makeMove(entry.packed, entry.undo);
+    const Move mv = entry.move;
 
-    return true;
+    ++m_historyIndex;
+    pushPosition();
+    switchPlayer();
+    updateGameState();
+
+    emit moveMade(mv);
+    emit boardChanged();
+    notifyHistoryChanged();
+    emit currentPlayerChanged(m_currentPlayer);
 }
 
 // ---------------------------------------------------------------------
@@ -735,44 +346,7 @@ bool GameController::isKingInCheck(Player side) const
     if (!m_board)
         return false;
 
-    const Board &board = *m_board;
-    const PieceColor myColor   = colorOf(side);
-    const Player     enemySide = opposite(side);
-
-    int kingRow = -1;
-    int kingCol = -1;
-
-    // Ищем короля данной стороны
-    for (int r = 0; r < Board::ROWS; ++r)
-    {
-        for (int c = 0; c < Board::COLS; ++c)
-        {
-            if (!board.isValidCell(r, c))
-                continue;
-
-            const Piece &p = board.pieceAt(r, c);
-            if (p.isEmpty())
-                continue;
-
-            if (p.kind == PieceKind::King && p.color == myColor)
-            {
-                kingRow = r;
-                kingCol = c;
-                break;
-            }
-        }
-        if (kingRow != -1)
-            break;
-    }
-
-    if (kingRow == -1)
-    {
-        // Теоретически этого быть не должно (мы запрещаем взятие короля),
-        // но на всякий случай считаем, что король "под бесконечным шахом".
-        return true;
-    }
-
-    return isSquareAttacked(kingRow, kingCol, enemySide);
+    return Rules::isKingInCheck(*m_board, colorOf(side));
 }
 
 bool GameController::isSquareAttacked(int row, int col, Player bySide) const
@@ -780,32 +354,26 @@ bool GameController::isSquareAttacked(int row, int col, Player bySide) const
     if (!m_board)
         return false;
 
-    const Board &board = *m_board;
-    const PieceColor attackColor = colorOf(bySide);
-
-    for (int r = 0; r < Board::ROWS; ++r)
-    {
-        for (int c = 0; c < Board::COLS; ++c)
-        {
-            if (!board.isValidCell(r, c))
-                continue;
-
-            const Piece &p = board.pieceAt(r, c);
-            if (p.isEmpty() || p.color != attackColor)
-                continue;
-
-            if (pieceAttacksSquare(board, p, r, c, row, col))
-                return true;
-        }
-    }
-
-    return false;
+    return Rules::isSquareAttacked(*m_board, row, col, colorOf(bySide));
 }
 
 // ---------------------------------------------------------------------
 // Внутренние служебные методы
 // ---------------------------------------------------------------------
 
+void GameController::resetPositions()
+{
+    // Запас на типичную партию: ходы не выделяют память
+    m_positions.clear();
+    m_positions.reserve(512);
+    pushPosition();
+}
+
+void GameController::pushPosition()
+{
+    m_positions.push_back(PositionRecord{m_board->hash(), m_board->halfmoveClock()});
+}
+
 void GameController::switchPlayer()
 {
     m_currentPlayer = opposite(m_currentPlayer);
@@ -820,20 +388,25 @@ void GameController::updateGameState()
         return;
     }
 
-    // Здесь трактуем gameState так:
-    //  - Running: король стороны, которой сейчас ходить, НЕ под шахом
-    //  - Check:   король стороны, которой сейчас ходить, ПОД шахом
-    //
-    // Мат/пат пока не определяем (это потребует полного генератора ходов).
-
-    if (isKingInCheck(m_currentPlayer))
-    {
-        m_gameState = GameState::Check;
-    }
+    // Состояние — для стороны, которой сейчас ходить:
+    //  - Running:   не под шахом, ходы есть
+    //  - Check:     под шахом, ходы есть
+    //  - Checkmate: под шахом, ходов нет
+    //  - Stalemate: не под шахом, ходов нет
+    //  - DrawByRepetition / DrawByFiftyMoves: ходы есть, но ничья
+    // Поиск хода останавливается на первом легальном (MoveGen::hasLegalMove).
+    // Мат последним ходом важнее правила 50 ходов и повторения.
+    const bool inCheck = isKingInCheck(m_currentPlayer);
+    const bool canMove = MoveGen::hasLegalMove(*m_board);
+
+    if (!canMove)
+        m_gameState = inCheck ? GameState::Checkmate : GameState::Stalemate;
+    else if (repetitionCount() >= 3)
+        m_gameState = GameState::DrawByRepetition;
+    else if (m_board->halfmoveClock() >= 100)
+        m_gameState = GameState::DrawByFiftyMoves;
     else
-    {
-        m_gameState = GameState::Running;
-    }
+        m_gameState = inCheck ? GameState::Check : GameState::Running;
 
     emit gameStateChanged(m_gameState);
 }
@@ -3,25 +3,13 @@
 #include <QObject>
 #include <vector>
 #include <cstddef>
+#include <random>
+#include <string>
 
-class Board;
-
-/// Простейшая координата на доске
-struct Position
-{
-    int row = 0;
-    int col = 0;
-
-    Position() = default;
-    Position(int r, int c) : row(r), col(c) {}
-};
-
-/// Описание хода: из клетки в клетку
-struct Move
-{
-    Position from;
-    Position to;
-};
+#include "../logic/Board.hpp"
+#include "../logic/Move.hpp"
+#include "../search/SmpSearch.hpp"
+#include "../db/OpeningBook.hpp"
 
 class GameController : public QObject
 {
@@ -38,7 +26,9 @@ public:
         Running,
         Check,
         Checkmate,
-        Stalemate
+        Stalemate,
+        DrawByRepetition,   // позиция повторилась трижды
+        DrawByFiftyMoves    // 50 ходов каждой стороны без взятий и ходов пешек
     };
     Q_ENUM(GameState)
 
@@ -58,6 +48,38 @@ public:
     bool canUndo() const noexcept;
     bool canRedo() const noexcept;
 
+    // Мат, пат или ничья — ходы больше не принимаются (undo доступен)
+    bool isGameOver() const noexcept;
+
+    // Сколько раз текущая позиция встречалась в партии (включая текущую)
+    int repetitionCount() const noexcept;
+
+    // --- Движок (search/, без Qt) ---
+    // Анализ текущей позиции; выполняется синхронно в вызывающем потоке
+    SearchResult analyze(const SearchLimits &limits);
+    // Сделать ход книги, если позиция в ней есть, иначе найти лучший ход
+    // и сделать его; false — ходов нет
+    bool makeEngineMove(const SearchLimits &limits);
+    // Прервать идущий analyze() (можно из другого потока)
+    void stopAnalysis() noexcept;
+    // Размер таблицы транспозиций движка; очищается при новой партии
+    void setHashSizeMb(std::size_t megabytes);
+    // Число потоков поиска (Lazy SMP), по умолчанию 1
+    void setSearchThreads(int threads);
+    // Оценивать нейросетью из файла весов (Nnue.hpp); false — файл не
+    // подошёл, движок остаётся на прежней оценке
+    bool loadNetwork(const std::string &path);
+
+    // --- Дебютная книга (db/OpeningBook.hpp) ---
+    // Открыть книгу; false — файл не подошёл, движок остаётся без книги.
+    // Пустой путь закрывает книгу
+    bool loadOpeningBook(const std::string &path);
+    bool hasOpeningBook() const noexcept;
+    // Ходы книги из текущей позиции, по убыванию веса; пусто — позиции в книге нет
+    std::vector<Db::BookEntry> bookMoves() const;
+    // Случайный с учётом весов ход книги для текущей позиции; PackedMove() — нет
+    PackedMove bookMove();
+
 public slots:
     void undo();
     void redo();
@@ -76,9 +98,6 @@ private:
     void updateGameState();
     void notifyHistoryChanged();
 
-    // Применить ход к доске (без истории, без смены игрока)
-    bool applyMoveOnBoard(const Move &move);
-
     // --- НОВОЕ: логика шаха ---
     bool isKingInCheck(Player side) const;                   // король side под ударом?
     bool isSquareAttacked(int row, int col, Player bySide) const; // клетка под атакой стороны bySide?
@@ -89,6 +108,34 @@ private:
     Player    m_currentPlayer = Player::White;
     GameState m_gameState     = GameState::Running;
 
-    std::vector<Move> m_history;
-    std::size_t       m_historyIndex = 0;
+    // Ход партии вместе с записью для его отката (undo/redo за O(1))
+    struct HistoryEntry
+    {
+        Move       move;
+        PackedMove packed;
+        UndoInfo   undo;
+    };
+
+    std::vector<HistoryEntry> m_history;
+    std::size_t               m_historyIndex = 0;
+
+    // Позиции партии от начальной до текущей (m_historyIndex + 1 записей):
+    // ключ Zobrist и счётчик полуходов правила 50 ходов. Повторения ищутся
+    // только назад до последнего необратимого хода, без выделений памяти
+    struct PositionRecord
+    {
+        std::uint64_t key;
+        int           halfmoveClock;
+    };
+
+    std::vector<PositionRecord> m_positions;
+
+    void resetPositions();
+    void pushPosition();
+
+    Nnue::Network  m_network;   // объявлена раньше m_search: переживает поиск
+    ParallelSearch m_search;
+
+    Db::OpeningBook m_book;
+    std::mt19937_64 m_bookRandom{std::random_device{}()};
 };
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Чтение и запись целых little-endian по байтам — общий порядок байт
+ * всех файлов db/ (GameFile, PositionIndex, OpeningBook). Побайтная
+ * сборка не зависит от порядка байт машины и от выравнивания: числа
+ * читаются прямо со страниц отображённого файла.
+ */
+namespace Db
+{
+    inline std::uint16_t readU16(const std::uint8_t *p) noexcept
+    {
+        return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    inline std::uint32_t readU32(const std::uint8_t *p) noexcept
+    {
+        return  static_cast<std::uint32_t>(p[0])
+             | (static_cast<std::uint32_t>(p[1]) << 8)
+             | (static_cast<std::uint32_t>(p[2]) << 16)
+             | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    inline std::uint64_t readU64(const std::uint8_t *p) noexcept
+    {
+        return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+    }
+
+    inline void writeU16(std::uint8_t *p, std::uint16_t v) noexcept
+    {
+        p[0] = static_cast<std::uint8_t>(v);
+        p[1] = static_cast<std::uint8_t>(v >> 8);
+    }
+
+    inline void writeU32(std::uint8_t *p, std::uint32_t v) noexcept
+    {
+        p[0] = static_cast<std::uint8_t>(v);
+        p[1] = static_cast<std::uint8_t>(v >> 8);
+        p[2] = static_cast<std::uint8_t>(v >> 16);
+        p[3] = static_cast<std::uint8_t>(v >> 24);
+    }
+
+    inline void writeU64(std::uint8_t *p, std::uint64_t v) noexcept
+    {
+        writeU32(p, static_cast<std::uint32_t>(v));
+        writeU32(p + 4, static_cast<std::uint32_t>(v >> 32));
+    }
+}
@@ -0,0 +1,419 @@
+#include "GameFile.hpp"
+#include "ByteOrder.hpp"
+#include "Fen.hpp"
+#include "MoveGen.hpp"
+#include "Notation.hpp"
+
+#include <cstring>
+
+namespace
+{
+    constexpr char MAGIC[8] = {'O', 'M', 'E', 'G', 'A', 'G', 'M', '\0'};
+
+    constexpr std::size_t HEADER_SIZE      = 32;
+    constexpr std::size_t GAME_HEADER_SIZE = 4;   // полуходы, результат, длина позиции
+
+    const char *resultText(Db::GameResult result) noexcept
+    {
+        switch (result)
+        {
+            case Db::GameResult::WhiteWin: return "1-0";
+            case Db::GameResult::BlackWin: return "0-1";
+            case Db::GameResult::Draw:     return "1/2-1/2";
+            default:                       return "*";
+        }
+    }
+
+    // Ход можно применить к доске, не нарушив её устройство: клетки
+    // существуют, ходит своя фигура, не на свою; рокировка — только
+    // как в генераторе
+    bool isPlayable(const Board &board, PackedMove move)
+    {
+        if (move.from() >= SQUARE_COUNT || move.to() >= SQUARE_COUNT)
+            return false;
+
+        const Piece &piece  = board.pieceAt(move.from());
+        const Piece &target = board.pieceAt(move.to());
+        if (piece.isEmpty() || piece.color != board.sideToMove() ||
+            (!target.isEmpty() && target.color == piece.color))
+        {
+            return false;
+        }
+
+        if (move.isCastling())
+        {
+            MoveList legal;
+            MoveGen::generateLegal(board, legal);
+            return legal.contains(move);
+        }
+        return true;
+    }
+
+    // Пишет партию текстом: номера ходов, ходы, перенос строк
+    class TextWriter : public Db::GameVisitor
+    {
+    public:
+        explicit TextWriter(std::FILE *out) : m_out(out) {}
+
+        void beginGame(const Board &start) override
+        {
+            m_lineLength = 0;
+            m_moveNumber = 1;
+            m_first      = start.sideToMove() == PieceColor::Black;
+        }
+
+        void move(const Board &before, PackedMove move) override
+        {
+            // Номер — перед ходом белых; партия с хода чёрных — «1...»
+            char text[32];
+            int n = 0;
+            if (before.sideToMove() == PieceColor::White)
+                n = std::snprintf(text, sizeof(text), "%d. ", m_moveNumber);
+            else if (m_first)
+                n = std::snprintf(text, sizeof(text), "%d... ", m_moveNumber);
+            m_first = false;
+
+            const std::string name = Notation::moveToString(move);
+            std::memcpy(text + n, name.data(), name.size());
+            n += static_cast<int>(name.size());
+
+            if (m_lineLength + n + 1 > LINE_WIDTH)
+            {
+                std::fputc('\n', m_out);
+                m_lineLength = 0;
+            }
+            else if (m_lineLength > 0)
+            {
+                std::fputc(' ', m_out);
+                ++m_lineLength;
+            }
+            std::fwrite(text, 1, static_cast<std::size_t>(n), m_out);
+            m_lineLength += n;
+
+            if (before.sideToMove() == PieceColor::Black)
+                ++m_moveNumber;
+        }
+
+        void endGame(const Db::GameSummary &summary) override
+        {
+            std::fprintf(m_out, "%s%s\n\n", m_lineLength > 0 ? " " : "", resultText(summary.result));
+        }
+
+    private:
+        static constexpr int LINE_WIDTH = 80;
+
+        std::FILE *m_out;
+        int        m_lineLength = 0;
+        int        m_moveNumber = 1;
+        bool       m_first      = false;
+    };
+
+    // Собирает партии текстового архива и дописывает их в бинарный
+    class BinaryPacker : public Db::GameVisitor
+    {
+    public:
+        explicit BinaryPacker(Db::GameFileWriter &writer) : m_writer(writer) {}
+
+        void beginGame(const Board &start) override
+        {
+            m_start = start;
+            m_moves.clear();
+        }
+
+        void move(const Board &before, PackedMove move) override
+        {
+            (void)before;
+            m_moves.push_back(move);
+        }
+
+        void endGame(const Db::GameSummary &summary) override
+        {
+            // Оборванные ошибкой партии в архив не попадают
+            if (summary.valid)
+                m_ok = m_writer.addGame(m_start, m_moves.data(), static_cast<int>(m_moves.size()),
+                                        summary.result) && m_ok;
+        }
+
+        bool ok() const noexcept { return m_ok; }
+
+    private:
+        Db::GameFileWriter     &m_writer;
+        Board                   m_start;
+        std::vector<PackedMove> m_moves;
+        bool                    m_ok = true;
+    };
+}
+
+namespace Db
+{
+    // -----------------------------------------------------------------
+    // GameView
+    // -----------------------------------------------------------------
+
+    bool GameView::startPosition(Board &board) const
+    {
+        if (fen.empty())
+        {
+            board.resetToInitialPosition();
+            return true;
+        }
+        return Fen::parse(fen, board);
+    }
+
+    bool GameView::replay(GameVisitor &visitor) const
+    {
+        Board board;
+        if (!startPosition(board))
+            return false;
+
+        visitor.beginGame(board);
+
+        GameSummary summary;
+        summary.result = result;
+
+        for (int i = 0; i < plies; ++i)
+        {
+            const PackedMove m = move(i);
+            if (!isPlayable(board, m))
+            {
+                summary.valid = false;
+                break;
+            }
+
+            visitor.move(board, m);
+            board.makeMove(m);
+            ++summary.plies;
+        }
+
+        visitor.endGame(summary);
+        return summary.valid;
+    }
+
+    // -----------------------------------------------------------------
+    // GameFile
+    // -----------------------------------------------------------------
+
+    bool GameFile::open(const std::string &path)
+    {
+        close();
+        if (!m_file.open(path))
+            return false;
+
+        const std::uint8_t *data = m_file.data();
+        const std::uint64_t size = m_file.size();
+
+        bool ok = size >= HEADER_SIZE &&
+                  std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0 &&
+                  readU32(data + 8) == GAME_FILE_VERSION;
+
+        if (ok)
+        {
+            m_gameCount   = readU64(data + 16);
+            m_indexOffset = readU64(data + 24);
+            ok = m_indexOffset >= HEADER_SIZE && m_indexOffset <= size &&
+                 m_gameCount <= (size - m_indexOffset) / sizeof(std::uint64_t);
+        }
+
+        if (!ok)
+            close();
+        return ok;
+    }
+
+    void GameFile::close() noexcept
+    {
+        m_file.close();
+        m_gameCount   = 0;
+        m_indexOffset = 0;
+    }
+
+    bool GameFile::game(std::uint64_t index, GameView &out) const noexcept
+    {
+        if (index >= m_gameCount)
+            return false;
+
+        const std::uint8_t *data   = m_file.data();
+        const std::uint64_t offset = readU64(data + m_indexOffset + index * sizeof(std::uint64_t));
+
+        // Запись партии целиком лежит между заголовком и индексом
+        if (offset < HEADER_SIZE || offset > m_indexOffset - GAME_HEADER_SIZE)
+            return false;
+
+        const std::uint8_t *p = data + offset;
+        const int plies     = p[0] | (p[1] << 8);
+        const int result    = p[2];
+        const int fenLength = p[3];
+
+        if (result > static_cast<int>(GameResult::Draw) ||
+            offset + GAME_HEADER_SIZE + fenLength + 2 * static_cast<std::uint64_t>(plies) > m_indexOffset)
+        {
+            return false;
+        }
+
+        out.result = static_cast<GameResult>(result);
+        out.plies  = plies;
+        out.fen    = std::string_view(reinterpret_cast<const char *>(p + GAME_HEADER_SIZE),
+                                      static_cast<std::size_t>(fenLength));
+        out.moves  = p + GAME_HEADER_SIZE + fenLength;
+        return true;
+    }
+
+    // -----------------------------------------------------------------
+    // GameFileWriter
+    // -----------------------------------------------------------------
+
+    GameFileWriter::~GameFileWriter()
+    {
+        close();
+    }
+
+    bool GameFileWriter::open(const std::string &path)
+    {
+        close();
+
+        m_file = std::fopen(path.c_str(), "wb");
+        if (!m_file)
+            return false;
+
+        m_offset = 0;
+        m_ok     = true;
+        m_offsets.clear();
+
+        Board initial;
+        initial.resetToInitialPosition();
+        m_initialHash = initial.hash();
+
+        // Заголовок перезаписывается в close(), когда известен индекс
+        const std::uint8_t header[HEADER_SIZE] = {};
+        return write(header, sizeof(header));
+    }
+
+    bool GameFileWriter::addGame(const Board &start, const PackedMove *moves, int count, GameResult result)
+    {
+        if (!m_file || count < 0 || count > MAX_GAME_PLIES)
+            return false;
+
+        char fen[Fen::MAX_LENGTH];
+        std::size_t fenLength = 0;
+        if (start.hash() != m_initialHash)
+            fenLength = Fen::write(start, fen, sizeof(fen));
+
+        m_offsets.push_back(m_offset);
+
+        std::uint8_t header[GAME_HEADER_SIZE];
+        writeU16(header, static_cast<std::uint16_t>(count));
+        header[2] = static_cast<std::uint8_t>(result);
+        header[3] = static_cast<std::uint8_t>(fenLength);
+
+        // Ходы — кусками через небольшой буфер на стеке
+        std::uint8_t packed[512];
+        bool ok = write(header, sizeof(header)) && write(fen, fenLength);
+        for (int i = 0; ok && i < count; )
+        {
+            std::size_t n = 0;
+            for (; i < count && n < sizeof(packed); ++i, n += 2)
+                writeU16(packed + n, moves[i].raw());
+            ok = write(packed, n);
+        }
+        return ok;
+    }
+
+    bool GameFileWriter::close()
+    {
+        if (!m_file)
+            return m_ok;
+
+        const std::uint64_t indexOffset = m_offset;
+        for (std::uint64_t offset : m_offsets)
+        {
+            std::uint8_t entry[sizeof(std::uint64_t)];
+            writeU64(entry, offset);
+            write(entry, sizeof(entry));
+        }
+
+        std::uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        writeU32(header + 8, GAME_FILE_VERSION);
+        writeU64(header + 16, m_offsets.size());
+        writeU64(header + 24, indexOffset);
+
+        m_ok = m_ok && std::fseek(m_file, 0, SEEK_SET) == 0 &&
+               std::fwrite(header, 1, sizeof(header), m_file) == sizeof(header);
+        m_ok = (std::fclose(m_file) == 0) && m_ok;
+        m_file = nullptr;
+        return m_ok;
+    }
+
+    bool GameFileWriter::write(const void *data, std::size_t size)
+    {
+        m_ok = m_ok && std::fwrite(data, 1, size, m_file) == size;
+        m_offset += size;
+        return m_ok;
+    }
+
+    // -----------------------------------------------------------------
+    // Преобразования
+    // -----------------------------------------------------------------
+
+    bool textToBinary(const std::string &textPath, const std::string &binaryPath, ReaderStats *stats)
+    {
+        GameFileWriter writer;
+        if (!writer.open(binaryPath))
+            return false;
+
+        BinaryPacker packer(writer);
+        GameReader reader(packer);
+        const bool read = reader.readFile(textPath);
+        if (stats)
+            *stats = reader.stats();
+
+        return writer.close() && read && packer.ok();
+    }
+
+    bool binaryToText(const std::string &binaryPath, const std::string &textPath)
+    {
+        GameFile games;
+        if (!games.open(binaryPath))
+            return false;
+
+        std::FILE *out = std::fopen(textPath.c_str(), "wb");
+        if (!out)
+            return false;
+
+        TextWriter writer(out);
+        bool ok = true;
+        for (std::uint64_t i = 0; ok && i < games.gameCount(); ++i)
+        {
+            GameView game;
+            ok = games.game(i, game);
+            if (!ok)
+                break;
+
+            std::fprintf(out, "[Result \"%s\"]\n", resultText(game.result));
+            if (!game.fen.empty())
+                std::fprintf(out, "[FEN \"%.*s\"]\n", static_cast<int>(game.fen.size()), game.fen.data());
+            std::fputc('\n', out);
+
+            ok = game.replay(writer);
+        }
+
+        return (std::fclose(out) == 0) && ok;
+    }
+
+    bool replayArchive(const std::string &path, GameVisitor &visitor)
+    {
+        GameFile games;
+        if (games.open(path))
+        {
+            for (std::uint64_t i = 0; i < games.gameCount(); ++i)
+            {
+                GameView game;
+                if (games.game(i, game))
+                    game.replay(visitor);
+            }
+            return true;
+        }
+
+        GameReader reader(visitor);
+        return reader.readFile(path);
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "ByteOrder.hpp"
+#include "GameReader.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+
+/**
+ * Компактный бинарный формат архива партий с индексом.
+ *
+ * Формат файла (little-endian):
+ *  - заголовок 32 байта: "OMEGAGM\0", версия (uint32), резерв (uint32),
+ *    число партий (uint64), смещение индекса (uint64);
+ *  - партии подряд; партия — число полуходов (uint16), результат
+ *    (uint8, Db::GameResult), длина записи начальной позиции (uint8,
+ *    0 — начальная позиция Omega), запись Fen.hpp этой длины и ходы
+ *    по 2 байта (PackedMove::raw(): откуда, куда, флаг);
+ *  - индекс: смещение каждой партии от начала файла (uint64).
+ *
+ * Теги, комментарии и варианты текстового архива не сохраняются — только
+ * то, что нужно для воспроизведения партии. Чтение — через отображение
+ * файла в память (MappedFile): партия с номером i находится за O(1)
+ * по индексу, ходы читаются прямо со страниц файла.
+ */
+namespace Db
+{
+    constexpr std::uint32_t GAME_FILE_VERSION = 1;
+
+    // Наибольшее число полуходов в одной партии формата
+    constexpr int MAX_GAME_PLIES = 0xFFFF;
+
+    /// Партия внутри отображённого файла (действительна, пока открыт GameFile)
+    struct GameView
+    {
+        GameResult         result = GameResult::Unknown;
+        int                plies  = 0;
+        std::string_view   fen;                // пусто — начальная позиция
+        const std::uint8_t *moves = nullptr;   // plies ходов по 2 байта
+
+        PackedMove move(int i) const noexcept
+        {
+            return PackedMove::fromRaw(readU16(moves + 2 * i));
+        }
+
+        // Начальная позиция партии; false — запись позиции испорчена
+        bool startPosition(Board &board) const;
+
+        // Проиграть партию в visitor (beginGame, move на каждый ход, endGame).
+        // Ходы проверены при записи и заново правилами не проверяются — только
+        // что клетки существуют и ходит фигура стороны хода; иначе false
+        bool replay(GameVisitor &visitor) const;
+    };
+
+    /// Чтение архива: открыть, затем game(i) в любом порядке
+    class GameFile
+    {
+    public:
+        // false — файла нет, чужой формат или версия, индекс не влезает в файл
+        bool open(const std::string &path);
+        void close() noexcept;
+
+        bool isOpen() const noexcept { return m_file.isOpen(); }
+
+        std::uint64_t gameCount() const noexcept { return m_gameCount; }
+
+        // Партия по номеру за O(1); false — номер вне диапазона или запись испорчена
+        bool game(std::uint64_t index, GameView &out) const noexcept;
+
+    private:
+        MappedFile    m_file;
+        std::uint64_t m_gameCount   = 0;
+        std::uint64_t m_indexOffset = 0;
+    };
+
+    /// Запись архива: партии дописываются по одной, индекс — в close()
+    class GameFileWriter
+    {
+    public:
+        GameFileWriter() = default;
+        ~GameFileWriter();
+
+        GameFileWriter(const GameFileWriter &) = delete;
+        GameFileWriter &operator=(const GameFileWriter &) = delete;
+
+        bool open(const std::string &path);
+
+        // Партия из позиции start; false — ошибка записи или больше MAX_GAME_PLIES ходов
+        bool addGame(const Board &start, const PackedMove *moves, int count, GameResult result);
+
+        // Дописать индекс и заголовок; false — ошибка записи
+        bool close();
+
+        std::uint64_t gameCount() const noexcept { return m_offsets.size(); }
+
+    private:
+        bool write(const void *data, std::size_t size);
+
+        std::FILE                 *m_file        = nullptr;
+        std::uint64_t              m_offset      = 0;   // текущая позиция записи
+        bool                       m_ok          = true;
+        std::uint64_t              m_initialHash = 0;   // ключ начальной позиции: её запись не нужна
+        std::vector<std::uint64_t> m_offsets;
+    };
+
+    // Текстовый архив (GameReader) → бинарный; stats — итоги чтения текста
+    bool textToBinary(const std::string &textPath, const std::string &binaryPath,
+                      ReaderStats *stats = nullptr);
+
+    // Бинарный архив → текстовый, который снова читается GameReader
+    bool binaryToText(const std::string &binaryPath, const std::string &textPath);
+
+    // Проиграть в visitor все партии архива: бинарный (GameFile) узнаётся
+    // по заголовку, иначе файл читается как текст (GameReader).
+    // false — файл не открылся
+    bool replayArchive(const std::string &path, GameVisitor &visitor);
+}
@@ -0,0 +1,377 @@
+#include "GameReader.hpp"
+#include "Clock.hpp"
+#include "Fen.hpp"
+#include "Notation.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+    bool isSpace(char ch) noexcept
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    // Символы, на которых кончается лексема хода
+    bool isDelimiter(char ch) noexcept
+    {
+        return isSpace(ch) || ch == '{' || ch == '}' || ch == ';' || ch == '(' || ch == ')';
+    }
+
+    bool isDigit(char ch) noexcept
+    {
+        return ch >= '0' && ch <= '9';
+    }
+
+    bool resultFromText(std::string_view text, Db::GameResult &result) noexcept
+    {
+        if (text == "1-0")
+            result = Db::GameResult::WhiteWin;
+        else if (text == "0-1")
+            result = Db::GameResult::BlackWin;
+        else if (text == "1/2-1/2")
+            result = Db::GameResult::Draw;
+        else if (text == "*")
+            result = Db::GameResult::Unknown;
+        else
+            return false;
+        return true;
+    }
+}
+
+namespace Db
+{
+    GameReader::GameReader(GameVisitor &visitor, std::size_t bufferSize)
+        : m_visitor(visitor)
+        , m_buffer(bufferSize > 0 ? bufferSize : DEFAULT_BUFFER)
+    {
+        reset();
+    }
+
+    bool GameReader::readFile(const std::string &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+
+        readStream(file);
+        std::fclose(file);
+        return true;
+    }
+
+    void GameReader::readStream(std::FILE *file)
+    {
+        reset();
+        const auto start = std::chrono::steady_clock::now();
+
+        char *const data = m_buffer.data();
+        std::size_t filled = 0;
+
+        for (;;)
+        {
+            const std::size_t n = std::fread(data + filled, 1, m_buffer.size() - filled, file);
+            m_stats.bytes += n;
+            filled += n;
+
+            if (n == 0)
+            {
+                consume(std::string_view(data, filled));
+                break;
+            }
+
+            // Разбираем до конца последней целой строки; если строка
+            // длиннее буфера — хотя бы до конца последней лексемы
+            std::size_t cut = filled;
+            while (cut > 0 && data[cut - 1] != '\n')
+                --cut;
+            if (cut == 0)
+            {
+                cut = filled;
+                while (cut > 0 && !isSpace(data[cut - 1]))
+                    --cut;
+            }
+
+            if (cut == 0)
+            {
+                // Одна лексема на весь буфер — это не ход; партия испорчена
+                if (filled == m_buffer.size())
+                {
+                    failGame();
+                    filled = 0;
+                }
+                continue;
+            }
+
+            consume(std::string_view(data, cut));
+            std::memmove(data, data + cut, filled - cut);
+            filled -= cut;
+        }
+
+        finish();
+        m_stats.seconds = secondsSince(start);
+    }
+
+    void GameReader::readText(std::string_view text)
+    {
+        reset();
+        const auto start = std::chrono::steady_clock::now();
+
+        m_stats.bytes = text.size();
+        consume(text);
+        finish();
+
+        m_stats.seconds = secondsSince(start);
+    }
+
+    void GameReader::reset()
+    {
+        m_stats = ReaderStats();
+
+        m_lineStart    = true;
+        m_lineComment  = false;
+        m_braceComment = false;
+        m_variation    = 0;
+
+        m_board.resetToInitialPosition();
+        m_inGame    = false;
+        m_inMoves   = false;
+        m_begun     = false;
+        m_invalid   = false;
+        m_plies     = 0;
+        m_tagResult = GameResult::Unknown;
+    }
+
+    void GameReader::consume(std::string_view text)
+    {
+        const char *p   = text.data();
+        const char *end = p + text.size();
+
+        while (p < end)
+        {
+            const char ch = *p;
+
+            if (m_lineComment)
+            {
+                if (ch == '\n')
+                {
+                    m_lineComment = false;
+                    m_lineStart   = true;
+                }
+                ++p;
+                continue;
+            }
+
+            if (m_braceComment)
+            {
+                if (ch == '}')
+                    m_braceComment = false;
+                ++p;
+                continue;
+            }
+
+            if (ch == '\n')
+            {
+                m_lineStart = true;
+                ++p;
+                continue;
+            }
+
+            if (isSpace(ch))
+            {
+                ++p;
+                continue;
+            }
+
+            if (m_lineStart && ch == '[')
+            {
+                m_lineStart = false;
+
+                const char *close = p + 1;
+                while (close < end && *close != ']' && *close != '\n')
+                    ++close;
+
+                if (close < end && *close == ']')
+                {
+                    handleTag(std::string_view(p + 1, static_cast<std::size_t>(close - p - 1)));
+                    p = close + 1;
+                }
+                else
+                {
+                    // Тег без закрывающей скобки — строка пропускается
+                    m_lineComment = true;
+                    p = close;
+                }
+                continue;
+            }
+
+            if (m_lineStart && ch == '%')
+            {
+                m_lineComment = true;
+                ++p;
+                continue;
+            }
+
+            m_lineStart = false;
+
+            switch (ch)
+            {
+                case '{': m_braceComment = true; ++p; continue;
+                case ';': m_lineComment  = true; ++p; continue;
+                case '(': ++m_variation;         ++p; continue;
+                case ')':
+                    if (m_variation > 0)
+                        --m_variation;
+                    ++p;
+                    continue;
+                case '}':
+                    ++p;
+                    continue;
+                default:
+                    break;
+            }
+
+            const char *tokenEnd = p + 1;
+            while (tokenEnd < end && !isDelimiter(*tokenEnd))
+                ++tokenEnd;
+
+            handleToken(std::string_view(p, static_cast<std::size_t>(tokenEnd - p)));
+            p = tokenEnd;
+        }
+    }
+
+    void GameReader::finish()
+    {
+        finishGame(GameResult::Unknown);
+
+        m_lineStart    = true;
+        m_lineComment  = false;
+        m_braceComment = false;
+        m_variation    = 0;
+    }
+
+    void GameReader::handleTag(std::string_view tag)
+    {
+        // Теги после ходов — уже следующая партия (у прошлой не было результата)
+        if (m_inMoves)
+            finishGame(GameResult::Unknown);
+
+        m_inGame = true;
+
+        std::size_t nameEnd = 0;
+        while (nameEnd < tag.size() && !isSpace(tag[nameEnd]))
+            ++nameEnd;
+        const std::string_view name = tag.substr(0, nameEnd);
+
+        const std::size_t open  = tag.find('"');
+        const std::size_t close = tag.rfind('"');
+        if (open == std::string_view::npos || close == open)
+            return;
+        const std::string_view value = tag.substr(open + 1, close - open - 1);
+
+        if (name == "FEN")
+        {
+            if (!Fen::parse(value, m_board))
+                failGame();
+        }
+        else if (name == "Result")
+        {
+            GameResult result = GameResult::Unknown;
+            if (resultFromText(value, result))
+                m_tagResult = result;
+        }
+    }
+
+    void GameReader::handleToken(std::string_view token)
+    {
+        if (m_variation > 0 || token[0] == '$')
+            return;
+
+        GameResult result = GameResult::Unknown;
+        if (resultFromText(token, result))
+        {
+            finishGame(result);
+            return;
+        }
+
+        // Номер хода: «12.», «12...», а также «...» и «12.e1e3»
+        std::size_t i = 0;
+        while (i < token.size() && isDigit(token[i]))
+            ++i;
+        if (i == 0 || (i < token.size() && token[i] == '.'))
+        {
+            while (i < token.size() && token[i] == '.')
+                ++i;
+            token.remove_prefix(i);
+        }
+        if (token.empty())
+            return;
+
+        // Оценочные знаки и шах/мат после хода
+        while (!token.empty() && std::strchr("!?+#", token.back()) != nullptr)
+            token.remove_suffix(1);
+
+        m_inGame  = true;
+        m_inMoves = true;
+        if (m_invalid)
+            return;
+
+        beginGameIfNeeded();
+
+        const PackedMove move = Notation::parseMove(m_board, token);
+        if (move.isNone())
+        {
+            failGame();
+            return;
+        }
+
+        m_visitor.move(m_board, move);
+        m_board.makeMove(move);
+        ++m_plies;
+        ++m_stats.moves;
+    }
+
+    void GameReader::beginGameIfNeeded()
+    {
+        if (m_begun)
+            return;
+        m_begun = true;
+        m_visitor.beginGame(m_board);
+    }
+
+    void GameReader::finishGame(GameResult result)
+    {
+        // Результат без тегов и ходов (или конец файла после партии) — не партия
+        if (!m_inGame)
+            return;
+
+        ++m_stats.games;
+        if (m_invalid)
+            ++m_stats.invalidGames;
+        else
+            beginGameIfNeeded();
+
+        if (m_begun)
+        {
+            GameSummary summary;
+            summary.result = (result != GameResult::Unknown) ? result : m_tagResult;
+            summary.plies  = m_plies;
+            summary.valid  = !m_invalid;
+            m_visitor.endGame(summary);
+        }
+
+        m_board.resetToInitialPosition();
+        m_inGame    = false;
+        m_inMoves   = false;
+        m_begun     = false;
+        m_invalid   = false;
+        m_plies     = 0;
+        m_tagResult = GameResult::Unknown;
+    }
+
+    void GameReader::failGame()
+    {
+        m_inGame  = true;
+        m_invalid = true;
+    }
+}
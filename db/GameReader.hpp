@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * Потоковое чтение архивов партий Omega Chess в духе PGN.
+ *
+ * Формат партии:
+ *
+ *   [Event "..."]
+ *   [FEN "<позиция Fen.hpp>"]      — необязательно, иначе начальная
+ *   [Result "1-0"]
+ *
+ *   1. e1e3 e8e6 2. d0g3 {комментарий} d9d6 (1... вариант) 1-0
+ *
+ * Ходы — в записи Notation (две клетки, рокировка — ходом короля);
+ * номера ходов, комментарии {…} и ;…, варианты (…), NAG ($n), знаки
+ * «!?+#» и строки «%» пропускаются. Партия кончается результатом
+ * (1-0, 0-1, 1/2-1/2, *), началом тегов следующей партии или концом файла.
+ *
+ * Файл читается кусками в буфер фиксированного размера: память не
+ * зависит от размера архива, файлы больше ОЗУ читаются так же. Лексемы —
+ * std::string_view внутри буфера, без выделений памяти на лексему.
+ * Строка тега должна целиком помещаться в буфер (иначе пропускается).
+ * Каждый ход проверяется генератором легальных ходов (те же правила,
+ * что у Rules и GameController) и применяется к доске; партия с
+ * нелегальным или нераспознанным ходом дальше не читается и считается
+ * ошибочной, чтение продолжается со следующей партии.
+ */
+namespace Db
+{
+    enum class GameResult : std::uint8_t
+    {
+        Unknown  = 0,
+        WhiteWin = 1,
+        BlackWin = 2,
+        Draw     = 3
+    };
+
+    struct GameSummary
+    {
+        GameResult result = GameResult::Unknown;
+        int        plies  = 0;      // применённых ходов
+        bool       valid  = true;   // false — партия оборвана ошибкой
+    };
+
+    /**
+     * Получатель партий. Для каждой партии: beginGame, затем move на
+     * каждый ход (позиция до хода и сам ход), затем endGame.
+     */
+    class GameVisitor
+    {
+    public:
+        virtual ~GameVisitor() = default;
+
+        virtual void beginGame(const Board &start) { (void)start; }
+        virtual void move(const Board &before, PackedMove move) = 0;
+        virtual void endGame(const GameSummary &summary) { (void)summary; }
+    };
+
+    /// Итоги чтения
+    struct ReaderStats
+    {
+        std::uint64_t games        = 0;   // всего партий, включая ошибочные
+        std::uint64_t invalidGames = 0;
+        std::uint64_t moves        = 0;
+        std::uint64_t bytes        = 0;
+        double        seconds      = 0.0;
+
+        double gamesPerSecond() const noexcept
+        {
+            return seconds > 0.0 ? static_cast<double>(games) / seconds : 0.0;
+        }
+    };
+
+    class GameReader
+    {
+    public:
+        static constexpr std::size_t DEFAULT_BUFFER = std::size_t{1} << 20;
+
+        explicit GameReader(GameVisitor &visitor, std::size_t bufferSize = DEFAULT_BUFFER);
+
+        // Прочитать файл целиком; false — файл не открылся
+        bool readFile(const std::string &path);
+
+        // Прочитать поток до конца (например, stdin)
+        void readStream(std::FILE *file);
+
+        // Прочитать текст, уже находящийся в памяти
+        void readText(std::string_view text);
+
+        // Итоги последнего чтения
+        const ReaderStats &stats() const noexcept { return m_stats; }
+
+    private:
+        void reset();
+
+        // Разобрать текст; он должен кончаться на границе лексем
+        void consume(std::string_view text);
+        void finish();
+
+        void handleTag(std::string_view tag);
+        void handleToken(std::string_view token);
+
+        void beginGameIfNeeded();
+        void finishGame(GameResult result);
+        void failGame();
+
+        GameVisitor      &m_visitor;
+        std::vector<char> m_buffer;   // размер фиксирован в конструкторе
+        ReaderStats       m_stats;
+
+        // Состояние разбора между кусками
+        bool m_lineStart    = true;
+        bool m_lineComment  = false;
+        bool m_braceComment = false;
+        int  m_variation    = 0;
+
+        // Текущая партия
+        Board      m_board;
+        bool       m_inGame    = false;   // встречены теги или ходы
+        bool       m_inMoves   = false;   // встречены ходы
+        bool       m_begun     = false;   // beginGame уже вызван
+        bool       m_invalid   = false;
+        int        m_plies     = 0;
+        GameResult m_tagResult = GameResult::Unknown;
+    };
+}
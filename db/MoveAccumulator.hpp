@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Накопитель записей (позиция, ход) для построителей PositionIndex и
+ * OpeningBook.
+ *
+ * Entry — структура с полями key (ключ позиции) и move (ход) и методом
+ * add(const Entry &), складывающим счётчики одинаковой пары. Записи
+ * копятся в памяти и время от времени сливаются (сортировка и сложение
+ * одинаковых пар), так что память растёт с числом разных пар, а не с
+ * числом партий.
+ */
+namespace Db
+{
+    template <typename Entry>
+    class MoveAccumulator
+    {
+    public:
+        // Записи одной партии: повторение позиции с тем же ходом — одна
+        // партия, а не две. Порядок записей game не сохраняется
+        static void removeRepeats(std::vector<Entry> &game)
+        {
+            std::sort(game.begin(), game.end(), less);
+            game.erase(std::unique(game.begin(), game.end(), [](const Entry &a, const Entry &b)
+            {
+                return a.key == b.key && a.move == b.move;
+            }), game.end());
+        }
+
+        void add(const Entry &e) { m_entries.push_back(e); }
+
+        // Конец партии: слить записи, если их накопилось много
+        void endGame()
+        {
+            if (m_entries.size() < m_mergeAt)
+                return;
+
+            merge();
+            // Почти нечего сливать — следующий раз позже, чтобы не сортировать зря
+            if (m_entries.size() > m_mergeAt / 2)
+                m_mergeAt *= 2;
+        }
+
+        // Отсортировать записи по (ключ, ход) и сложить одинаковые пары
+        void merge()
+        {
+            std::sort(m_entries.begin(), m_entries.end(), less);
+
+            std::size_t out = 0;
+            for (std::size_t i = 0; i < m_entries.size(); ++i)
+            {
+                const Entry &e = m_entries[i];
+                if (out > 0 && m_entries[out - 1].key == e.key && m_entries[out - 1].move == e.move)
+                    m_entries[out - 1].add(e);
+                else
+                    m_entries[out++] = e;
+            }
+            m_entries.resize(out);
+        }
+
+        // После merge() — по возрастанию ключа, внутри позиции — хода
+        const std::vector<Entry> &entries() const noexcept { return m_entries; }
+
+    private:
+        // Слияние сначала при таком размере, потом — реже
+        static constexpr std::size_t FIRST_MERGE = std::size_t{1} << 20;
+
+        static bool less(const Entry &a, const Entry &b) noexcept
+        {
+            return a.key != b.key ? a.key < b.key : a.move < b.move;
+        }
+
+        std::vector<Entry> m_entries;
+        std::size_t        m_mergeAt = FIRST_MERGE;   // размер, при котором пора сливать
+    };
+}
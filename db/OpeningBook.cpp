@@ -0,0 +1,226 @@
+#include "OpeningBook.hpp"
+#include "ByteOrder.hpp"
+#include "MoveGen.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr char MAGIC[8] = {'O', 'M', 'E', 'G', 'A', 'B', 'K', '\0'};
+
+    constexpr std::size_t HEADER_SIZE = 16;
+    constexpr std::size_t ENTRY_SIZE  = 16;   // ключ, ход, вес, партии
+
+    constexpr std::uint64_t MAX_WEIGHT = 0xFFFF;
+}
+
+namespace Db
+{
+    // -----------------------------------------------------------------
+    // OpeningBook
+    // -----------------------------------------------------------------
+
+    bool OpeningBook::open(const std::string &path)
+    {
+        close();
+        if (!m_file.open(path))
+            return false;
+
+        const std::uint8_t *data = m_file.data();
+        const std::size_t   size = m_file.size();
+
+        const bool ok = size >= HEADER_SIZE &&
+                        std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0 &&
+                        readU32(data + 8) == OPENING_BOOK_VERSION &&
+                        (size - HEADER_SIZE) % ENTRY_SIZE == 0;
+        if (!ok)
+        {
+            close();
+            return false;
+        }
+
+        m_entries    = data + HEADER_SIZE;
+        m_entryCount = (size - HEADER_SIZE) / ENTRY_SIZE;
+        return true;
+    }
+
+    void OpeningBook::close() noexcept
+    {
+        m_file.close();
+        m_entryCount = 0;
+        m_entries    = nullptr;
+    }
+
+    std::size_t OpeningBook::find(std::uint64_t key, BookEntry *out, std::size_t capacity) const noexcept
+    {
+        if (!m_entries)
+            return 0;
+
+        // Первая запись с ключом не меньше key
+        std::uint64_t lo = 0;
+        std::uint64_t hi = m_entryCount;
+        while (lo < hi)
+        {
+            const std::uint64_t mid = lo + (hi - lo) / 2;
+            if (readU64(m_entries + mid * ENTRY_SIZE) < key)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        std::size_t found = 0;
+        for (std::uint64_t i = lo; i < m_entryCount && readU64(m_entries + i * ENTRY_SIZE) == key; ++i, ++found)
+        {
+            if (found >= capacity)
+                continue;
+
+            const std::uint8_t *e = m_entries + i * ENTRY_SIZE;
+            BookEntry &entry = out[found];
+            entry.move   = PackedMove::fromRaw(readU16(e + 8));
+            entry.weight = readU16(e + 10);
+            entry.games  = readU32(e + 12);
+        }
+        return found;
+    }
+
+    std::vector<BookEntry> OpeningBook::entries(const Board &board) const
+    {
+        std::vector<BookEntry> result(32);
+        std::size_t count = find(board.hash(), result.data(), result.size());
+        if (count > result.size())
+        {
+            result.resize(count);
+            count = find(board.hash(), result.data(), result.size());
+        }
+        result.resize(count);
+        if (result.empty())
+            return result;
+
+        MoveList legal;
+        MoveGen::generateLegal(board, legal);
+        result.erase(std::remove_if(result.begin(), result.end(),
+                                    [&legal](const BookEntry &e) { return !legal.contains(e.move); }),
+                     result.end());
+        return result;
+    }
+
+    PackedMove OpeningBook::pick(const Board &board, std::uint64_t random) const
+    {
+        const std::vector<BookEntry> moves = entries(board);
+
+        std::uint64_t total = 0;
+        for (const BookEntry &e : moves)
+            total += e.weight;
+        if (total == 0)
+            return PackedMove();
+
+        // Записи идут по убыванию веса: random = 0 выбирает первую
+        std::uint64_t r = random % total;
+        for (const BookEntry &e : moves)
+        {
+            if (r < e.weight)
+                return e.move;
+            r -= e.weight;
+        }
+        return moves.front().move;
+    }
+
+    // -----------------------------------------------------------------
+    // OpeningBookBuilder
+    // -----------------------------------------------------------------
+
+    OpeningBookBuilder::OpeningBookBuilder(int maxPly, int minGames)
+        : m_maxPly(maxPly), m_minGames(minGames)
+    {
+    }
+
+    void OpeningBookBuilder::beginGame(const Board &start)
+    {
+        (void)start;
+        m_game.clear();
+        m_ply = 0;
+    }
+
+    void OpeningBookBuilder::move(const Board &before, PackedMove move)
+    {
+        if (m_ply++ < m_maxPly)
+            m_game.push_back(Entry{before.hash(), move.raw(), before.sideToMove() == PieceColor::White, 1, 0});
+    }
+
+    void OpeningBookBuilder::endGame(const GameSummary &summary)
+    {
+        // Оборванная ошибкой партия не учитывается вовсе
+        if (!summary.valid)
+            return;
+        ++m_gameCount;
+
+        // Иначе одна партия с повторениями сама прошла бы отбор по minGames
+        Accumulator::removeRepeats(m_game);
+
+        for (Entry e : m_game)
+        {
+            const bool won  = summary.result == (e.white ? GameResult::WhiteWin : GameResult::BlackWin);
+            const bool lost = summary.result == (e.white ? GameResult::BlackWin : GameResult::WhiteWin);
+            e.score = won ? 2 : (lost ? 0 : 1);
+            m_entries.add(e);
+        }
+        m_entries.endGame();
+    }
+
+    bool OpeningBookBuilder::write(const std::string &path)
+    {
+        m_entries.merge();
+        const std::vector<Entry> &entries = m_entries.entries();
+
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+
+        std::uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        writeU32(header + 8, OPENING_BOOK_VERSION);
+        bool ok = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+        // Позиции уже по возрастанию ключа; внутри позиции — отбор,
+        // масштаб весов и сортировка по убыванию веса
+        std::vector<Entry> position;
+        for (std::size_t begin = 0; ok && begin < entries.size(); )
+        {
+            std::size_t end = begin;
+            position.clear();
+            std::uint64_t maxScore = 0;
+            for (; end < entries.size() && entries[end].key == entries[begin].key; ++end)
+            {
+                const Entry &e = entries[end];
+                if (e.games >= static_cast<std::uint32_t>(m_minGames) && e.score > 0)
+                {
+                    position.push_back(e);
+                    maxScore = std::max(maxScore, e.score);
+                }
+            }
+            begin = end;
+
+            for (Entry &e : position)
+            {
+                if (maxScore > MAX_WEIGHT)
+                    e.score = std::max<std::uint64_t>(1, e.score * MAX_WEIGHT / maxScore);
+            }
+            std::stable_sort(position.begin(), position.end(),
+                             [](const Entry &a, const Entry &b) { return a.score > b.score; });
+
+            for (const Entry &e : position)
+            {
+                std::uint8_t bytes[ENTRY_SIZE];
+                writeU64(bytes, e.key);
+                writeU16(bytes + 8, e.move);
+                writeU16(bytes + 10, static_cast<std::uint16_t>(e.score));
+                writeU32(bytes + 12, e.games);
+                ok = ok && std::fwrite(bytes, 1, sizeof(bytes), file) == sizeof(bytes);
+            }
+        }
+
+        return (std::fclose(file) == 0) && ok;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "GameReader.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+#include "MoveAccumulator.hpp"
+
+/**
+ * Дебютная книга в духе Polyglot.
+ *
+ * Формат файла (little-endian):
+ *  - заголовок 16 байт: "OMEGABK\0", версия (uint32), резерв (uint32);
+ *  - записи по 16 байт: ключ позиции (uint64, Board::hash()), ход
+ *    (uint16, PackedMove::raw()), вес (uint16), число партий (uint32).
+ *
+ * Записи отсортированы по ключу, внутри позиции — по убыванию веса.
+ * В отличие от Polyglot ключ — Zobrist самой доски Omega (свои фигуры и
+ * клетки), а не таблица случайных чисел Polyglot. Файл отображается в
+ * память (MappedFile); поиск позиции — двоичный поиск по записям.
+ * Ход из книги перед выдачей проверяется генератором легальных ходов:
+ * совпадение ключей чужой позиции не даёт сыграть невозможный ход.
+ */
+namespace Db
+{
+    constexpr std::uint32_t OPENING_BOOK_VERSION = 1;
+
+    struct BookEntry
+    {
+        PackedMove    move;
+        std::uint16_t weight = 0;
+        std::uint32_t games  = 0;
+    };
+
+    class OpeningBook
+    {
+    public:
+        // false — файла нет, чужой формат или версия, размер не кратен записи
+        bool open(const std::string &path);
+        void close() noexcept;
+
+        bool isOpen() const noexcept { return m_file.isOpen(); }
+
+        std::uint64_t entryCount() const noexcept { return m_entryCount; }
+
+        // Записи позиции с ключом key, по убыванию веса. В out пишется
+        // не больше capacity записей; возвращается их общее число
+        std::size_t find(std::uint64_t key, BookEntry *out, std::size_t capacity) const noexcept;
+
+        // Легальные ходы книги из позиции board, по убыванию веса
+        std::vector<BookEntry> entries(const Board &board) const;
+
+        // Ход с вероятностью, пропорциональной весу: random — любое
+        // случайное число, 0 — самый тяжёлый ход. Нет хода — PackedMove()
+        PackedMove pick(const Board &board, std::uint64_t random) const;
+
+    private:
+        MappedFile          m_file;
+        std::uint64_t       m_entryCount = 0;
+        const std::uint8_t *m_entries    = nullptr;
+    };
+
+    /**
+     * Построение книги из партий (получатель GameReader или
+     * GameView::replay). Для первых maxPly полуходов каждой партии ход
+     * получает очки стороны, которая его сделала: 2 за победу, 1 за ничью
+     * или неизвестный итог, 0 за поражение; повторённая в партии пара
+     * (позиция, ход) считается один раз. В книгу попадают ходы,
+     * сыгранные не меньше minGames раз и набравшие очки; веса позиции
+     * масштабируются в uint16 так, чтобы их соотношение сохранилось.
+     */
+    class OpeningBookBuilder : public GameVisitor
+    {
+    public:
+        static constexpr int DEFAULT_MAX_PLY   = 20;
+        static constexpr int DEFAULT_MIN_GAMES = 2;
+
+        explicit OpeningBookBuilder(int maxPly = DEFAULT_MAX_PLY, int minGames = DEFAULT_MIN_GAMES);
+
+        void beginGame(const Board &start) override;
+        void move(const Board &before, PackedMove move) override;
+        void endGame(const GameSummary &summary) override;
+
+        std::uint64_t gameCount() const noexcept { return m_gameCount; }
+
+        // Записать книгу; false — ошибка записи
+        bool write(const std::string &path);
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key;
+            std::uint16_t move;
+            bool          white;    // ход белых (для очков по итогу партии)
+            std::uint32_t games;
+            std::uint64_t score;
+
+            void add(const Entry &other) noexcept
+            {
+                games += other.games;
+                score += other.score;
+            }
+        };
+        using Accumulator = MoveAccumulator<Entry>;
+
+        int                m_maxPly;
+        int                m_minGames;
+        Accumulator        m_entries;
+        std::vector<Entry> m_game;              // записи текущей партии
+        int                m_ply       = 0;
+        std::uint64_t      m_gameCount = 0;
+    };
+}
@@ -0,0 +1,261 @@
+#include "PositionIndex.hpp"
+#include "ByteOrder.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr char MAGIC[8] = {'O', 'M', 'E', 'G', 'A', 'P', 'I', '\0'};
+
+    constexpr std::size_t HEADER_SIZE = 48;
+    constexpr std::size_t ENTRY_SIZE  = 20;   // ход, резерв, четыре счётчика
+
+    // Корзин примерно в восемь раз меньше, чем записей
+    constexpr std::uint32_t MAX_BUCKET_BITS        = 24;
+    constexpr int           ENTRIES_PER_BUCKET_LOG = 3;
+
+    std::uint64_t bucketOf(std::uint64_t key, std::uint32_t bits) noexcept
+    {
+        return bits == 0 ? 0 : key >> (64 - bits);
+    }
+
+    // Запись в файл; после первой ошибки больше ничего не пишет
+    class FileWriter
+    {
+    public:
+        explicit FileWriter(std::FILE *file) : m_file(file) {}
+
+        bool write(const void *data, std::size_t size)
+        {
+            m_ok = m_ok && std::fwrite(data, 1, size, m_file) == size;
+            return m_ok;
+        }
+
+        bool writeWord(std::uint64_t v)
+        {
+            std::uint8_t bytes[sizeof(v)];
+            Db::writeU64(bytes, v);
+            return write(bytes, sizeof(bytes));
+        }
+
+        bool ok() const noexcept { return m_ok; }
+
+    private:
+        std::FILE *m_file;
+        bool       m_ok = true;
+    };
+}
+
+namespace Db
+{
+    // -----------------------------------------------------------------
+    // PositionIndex
+    // -----------------------------------------------------------------
+
+    bool PositionIndex::open(const std::string &path)
+    {
+        close();
+        if (!m_file.open(path))
+            return false;
+
+        const std::uint8_t *data = m_file.data();
+        const std::uint64_t size = m_file.size();
+
+        bool ok = size >= HEADER_SIZE &&
+                  std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0 &&
+                  readU32(data + 8) == POSITION_INDEX_VERSION;
+
+        if (ok)
+        {
+            m_bucketBits = readU32(data + 12);
+            m_entryCount = readU64(data + 16);
+            m_gameCount  = readU64(data + 24);
+
+            const std::uint64_t bucketsOffset = readU64(data + 32);
+            const std::uint64_t keysOffset    = readU64(data + 40);
+            const std::uint64_t bucketBytes   = m_bucketBits <= MAX_BUCKET_BITS
+                                              ? ((std::uint64_t{1} << m_bucketBits) + 1) * sizeof(std::uint64_t)
+                                              : 0;
+
+            // Таблицы идут подряд и заканчиваются ровно в конце файла
+            ok = bucketBytes != 0 &&
+                 bucketsOffset == HEADER_SIZE &&
+                 keysOffset == bucketsOffset + bucketBytes &&
+                 m_entryCount <= (size - std::min(size, keysOffset)) / (sizeof(std::uint64_t) + ENTRY_SIZE) &&
+                 keysOffset + m_entryCount * (sizeof(std::uint64_t) + ENTRY_SIZE) == size;
+
+            if (ok)
+            {
+                m_buckets = data + bucketsOffset;
+                m_keys    = data + keysOffset;
+                m_entries = m_keys + m_entryCount * sizeof(std::uint64_t);
+
+                // Последняя граница корзин — число записей: дальше find не выйдет
+                ok = readU64(m_buckets + (std::uint64_t{1} << m_bucketBits) * sizeof(std::uint64_t)) == m_entryCount;
+            }
+        }
+
+        if (!ok)
+            close();
+        return ok;
+    }
+
+    void PositionIndex::close() noexcept
+    {
+        m_file.close();
+        m_entryCount = 0;
+        m_gameCount  = 0;
+        m_bucketBits = 0;
+        m_buckets    = nullptr;
+        m_keys       = nullptr;
+        m_entries    = nullptr;
+    }
+
+    std::size_t PositionIndex::find(std::uint64_t key, MoveStats *out, std::size_t capacity) const noexcept
+    {
+        if (!m_keys)
+            return 0;
+
+        // Корзина по старшим битам ключа, внутри неё — двоичный поиск
+        const std::uint64_t bucket = bucketOf(key, m_bucketBits);
+        std::uint64_t lo = readU64(m_buckets + bucket * sizeof(std::uint64_t));
+        std::uint64_t hi = std::min(readU64(m_buckets + (bucket + 1) * sizeof(std::uint64_t)), m_entryCount);
+
+        while (lo < hi)
+        {
+            const std::uint64_t mid = lo + (hi - lo) / 2;
+            if (readU64(m_keys + mid * sizeof(std::uint64_t)) < key)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        std::size_t found = 0;
+        for (std::uint64_t i = lo; i < m_entryCount && readU64(m_keys + i * sizeof(std::uint64_t)) == key; ++i, ++found)
+        {
+            if (found >= capacity)
+                continue;
+
+            const std::uint8_t *e = m_entries + i * ENTRY_SIZE;
+            MoveStats &stats = out[found];
+            stats.move      = PackedMove::fromRaw(readU16(e));
+            stats.games     = readU32(e + 4);
+            stats.whiteWins = readU32(e + 8);
+            stats.blackWins = readU32(e + 12);
+            stats.draws     = readU32(e + 16);
+        }
+        return found;
+    }
+
+    std::vector<MoveStats> PositionIndex::moves(const Board &board) const
+    {
+        std::vector<MoveStats> result(64);
+        std::size_t count = find(board.hash(), result.data(), result.size());
+        if (count > result.size())
+        {
+            result.resize(count);
+            count = find(board.hash(), result.data(), result.size());
+        }
+        result.resize(count);
+
+        std::stable_sort(result.begin(), result.end(),
+                         [](const MoveStats &a, const MoveStats &b) { return a.games > b.games; });
+        return result;
+    }
+
+    // -----------------------------------------------------------------
+    // PositionIndexBuilder
+    // -----------------------------------------------------------------
+
+    PositionIndexBuilder::PositionIndexBuilder(int maxPly)
+        : m_maxPly(maxPly)
+    {
+    }
+
+    void PositionIndexBuilder::beginGame(const Board &start)
+    {
+        (void)start;
+        m_game.clear();
+        m_ply = 0;
+    }
+
+    void PositionIndexBuilder::move(const Board &before, PackedMove move)
+    {
+        if (m_ply++ < m_maxPly)
+            m_game.push_back(Entry{before.hash(), move.raw(), 1, 0, 0, 0});
+    }
+
+    void PositionIndexBuilder::endGame(const GameSummary &summary)
+    {
+        // Оборванная ошибкой партия не учитывается вовсе
+        if (!summary.valid)
+            return;
+        ++m_gameCount;
+
+        // Повторение позиции с тем же ходом — одна партия, а не две
+        Accumulator::removeRepeats(m_game);
+
+        for (Entry e : m_game)
+        {
+            e.whiteWins = summary.result == GameResult::WhiteWin ? 1 : 0;
+            e.blackWins = summary.result == GameResult::BlackWin ? 1 : 0;
+            e.draws     = summary.result == GameResult::Draw ? 1 : 0;
+            m_entries.add(e);
+        }
+        m_entries.endGame();
+    }
+
+    bool PositionIndexBuilder::write(const std::string &path)
+    {
+        m_entries.merge();
+        const std::vector<Entry> &entries = m_entries.entries();
+
+        const std::uint64_t count = entries.size();
+        std::uint32_t bits = 0;
+        while (bits < MAX_BUCKET_BITS && (count >> (bits + ENTRIES_PER_BUCKET_LOG + 1)) != 0)
+            ++bits;
+        const std::uint64_t buckets = std::uint64_t{1} << bits;
+
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+        FileWriter out(file);
+
+        std::uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        writeU32(header + 8, POSITION_INDEX_VERSION);
+        writeU32(header + 12, bits);
+        writeU64(header + 16, count);
+        writeU64(header + 24, m_gameCount);
+        writeU64(header + 32, HEADER_SIZE);
+        writeU64(header + 40, HEADER_SIZE + (buckets + 1) * sizeof(std::uint64_t));
+        out.write(header, sizeof(header));
+
+        // Начало каждой корзины: записи отсортированы, значит и по корзинам
+        std::uint64_t next = 0;
+        for (std::uint64_t b = 0; b <= buckets; ++b)
+        {
+            while (next < count && bucketOf(entries[next].key, bits) < b)
+                ++next;
+            out.writeWord(next);
+        }
+
+        for (const Entry &e : entries)
+            out.writeWord(e.key);
+
+        for (const Entry &e : entries)
+        {
+            std::uint8_t bytes[ENTRY_SIZE] = {};
+            writeU16(bytes, e.move);
+            writeU32(bytes + 4, e.games);
+            writeU32(bytes + 8, e.whiteWins);
+            writeU32(bytes + 12, e.blackWins);
+            writeU32(bytes + 16, e.draws);
+            out.write(bytes, sizeof(bytes));
+        }
+
+        return (std::fclose(file) == 0) && out.ok();
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "GameReader.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+#include "MoveAccumulator.hpp"
+
+/**
+ * База позиций: какие ходы делались из позиции и с каким итогом.
+ *
+ * Ключ — Zobrist позиции (Board::hash(): фигуры, права на рокировку,
+ * сторона хода), поэтому перестановки ходов сходятся в одну запись.
+ * Для каждой пары (позиция, ход) хранится число партий и сколько из них
+ * выиграли белые, чёрные и сколько вничью.
+ *
+ * Формат файла (little-endian):
+ *  - заголовок 48 байт: "OMEGAPI\0", версия (uint32), число бит корзин
+ *    (uint32), число записей (uint64), число партий (uint64), смещения
+ *    таблицы корзин и ключей (uint64);
+ *  - таблица корзин: (1 << bits) + 1 номеров первой записи (uint64) —
+ *    корзина выбирается старшими битами ключа;
+ *  - ключи записей (uint64) по возрастанию — отдельным массивом, чтобы
+ *    двоичный поиск трогал только их;
+ *  - записи по 20 байт в том же порядке: ход (uint16), резерв (uint16),
+ *    партий, побед белых, побед чёрных, ничьих (uint32).
+ *
+ * Файл отображается в память (MappedFile): загрузки нет, поиск — корзина
+ * плюс двоичный поиск по нескольким ключам, единицы микросекунд.
+ */
+namespace Db
+{
+    constexpr std::uint32_t POSITION_INDEX_VERSION = 1;
+
+    /// Статистика одного хода из позиции
+    struct MoveStats
+    {
+        PackedMove    move;
+        std::uint32_t games     = 0;
+        std::uint32_t whiteWins = 0;
+        std::uint32_t blackWins = 0;
+        std::uint32_t draws     = 0;   // остальные партии — без результата
+    };
+
+    /// Чтение базы: открыть, затем find по ключу позиции
+    class PositionIndex
+    {
+    public:
+        // false — файла нет, чужой формат или версия, таблицы не влезают в файл
+        bool open(const std::string &path);
+        void close() noexcept;
+
+        bool isOpen() const noexcept { return m_file.isOpen(); }
+
+        std::uint64_t entryCount() const noexcept { return m_entryCount; }
+        std::uint64_t gameCount() const noexcept { return m_gameCount; }
+
+        // Ходы из позиции с ключом key (по возрастанию PackedMove::raw()).
+        // В out пишется не больше capacity ходов; возвращается их общее число
+        std::size_t find(std::uint64_t key, MoveStats *out, std::size_t capacity) const noexcept;
+
+        // Ходы из позиции board, самые частые — первыми
+        std::vector<MoveStats> moves(const Board &board) const;
+
+    private:
+        MappedFile          m_file;
+        std::uint64_t       m_entryCount = 0;
+        std::uint64_t       m_gameCount  = 0;
+        std::uint32_t       m_bucketBits = 0;
+        const std::uint8_t *m_buckets    = nullptr;
+        const std::uint8_t *m_keys       = nullptr;
+        const std::uint8_t *m_entries    = nullptr;
+    };
+
+    /**
+     * Построение базы из партий: получатель GameReader (текстовые архивы)
+     * или GameView::replay (бинарные). Учитываются первые maxPly полуходов
+     * каждой партии без ошибок; записи копит MoveAccumulator.
+     */
+    class PositionIndexBuilder : public GameVisitor
+    {
+    public:
+        static constexpr int DEFAULT_MAX_PLY = 40;
+
+        explicit PositionIndexBuilder(int maxPly = DEFAULT_MAX_PLY);
+
+        void beginGame(const Board &start) override;
+        void move(const Board &before, PackedMove move) override;
+        void endGame(const GameSummary &summary) override;
+
+        std::uint64_t gameCount() const noexcept { return m_gameCount; }
+
+        // Записать базу; false — ошибка записи
+        bool write(const std::string &path);
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key;
+            std::uint16_t move;
+            std::uint32_t games;
+            std::uint32_t whiteWins;
+            std::uint32_t blackWins;
+            std::uint32_t draws;
+
+            void add(const Entry &other) noexcept
+            {
+                games     += other.games;
+                whiteWins += other.whiteWins;
+                blackWins += other.blackWins;
+                draws     += other.draws;
+            }
+        };
+        using Accumulator = MoveAccumulator<Entry>;
+
+        int                m_maxPly;
+        Accumulator        m_entries;
+        std::vector<Entry> m_game;              // записи текущей партии
+        int                m_ply       = 0;
+        std::uint64_t      m_gameCount = 0;
+    };
+}
@@ -286,6 +286,12 @@ void MainWindow::onGameStateChanged(GameController::GameState state)
     case GameController::GameState::Stalemate:
         text = tr("Ничья");
         break;
+    case GameController::GameState::DrawByRepetition:
+        text = tr("Ничья: троекратное повторение");
+        break;
+    case GameController::GameState::DrawByFiftyMoves:
+        text = tr("Ничья: правило 50 ходов");
+        break;
     }
 
     m_statusLabel->setText(text);
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Bitboard.hpp"
+#include "Piece.hpp"
+#include "Square.hpp"
+
+/**
+ * Таблицы атак прыгающих фигур Omega Chess, построенные при компиляции.
+ *
+ * Для каждой из 104 валидных клеток хранится множество клеток, которые
+ * бьёт фигура с этой клетки. Клетки за пределами поля (включая
+ * «дыры» между основным полем и углами волшебников) отсечены.
+ *
+ * Шаблоны конь/король/чемпион/волшебник симметричны, поэтому та же
+ * таблица отвечает и на обратный вопрос: «кто с таких-то клеток бьёт sq».
+ *
+ * Скользящие фигуры (ладья, слон, ферзь) — через предвычисленные лучи:
+ * для каждой клетки и каждого из 8 направлений хранится луч до края
+ * поля. Нумерация клеток монотонна по (row, col), поэтому первая
+ * занятая клетка на луче — младший бит пересечения с занятостью для
+ * лучей «вниз/вправо» и старший — для «вверх/влево». Атаки по лучу —
+ * луч без своего продолжения за блокирующей фигурой.
+ */
+namespace Attacks
+{
+    using Table = std::array<Bitboard, SQUARE_COUNT>;
+
+    namespace detail
+    {
+        struct Offset
+        {
+            int dr;
+            int dc;
+        };
+
+        constexpr Offset KNIGHT[] = {
+            {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}
+        };
+
+        constexpr Offset KING[] = {
+            {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}
+        };
+
+        // Champion (WAD): шаг и прыжок на 2 по прямым, прыжок на 2 по диагоналям
+        constexpr Offset CHAMPION[] = {
+            {-1, 0}, {1, 0}, {0, -1}, {0, 1},
+            {-2, 0}, {2, 0}, {0, -2}, {0, 2},
+            {-2, -2}, {-2, 2}, {2, -2}, {2, 2}
+        };
+
+        // Wizard: шаг по диагонали (ферзь) и «верблюжий» прыжок 1×3
+        constexpr Offset WIZARD[] = {
+            {-1, -1}, {-1, 1}, {1, -1}, {1, 1},
+            {-1, -3}, {-1, 3}, {1, -3}, {1, 3},
+            {-3, -1}, {-3, 1}, {3, -1}, {3, 1}
+        };
+
+        // Взятия пешки: белые бьют вверх (меньшие row), чёрные — вниз
+        constexpr Offset WHITE_PAWN[] = { {-1, -1}, {-1, 1} };
+        constexpr Offset BLACK_PAWN[] = { {1, -1}, {1, 1} };
+
+        // Направления лучей: сначала с растущими индексами клеток, затем с убывающими
+        constexpr Offset RAY_DIRECTIONS[] = {
+            {1, 0}, {0, 1}, {1, 1}, {1, -1},     // вниз, вправо, вниз-вправо, вниз-влево
+            {-1, 0}, {0, -1}, {-1, -1}, {-1, 1}  // вверх, влево, вверх-влево, вверх-вправо
+        };
+
+        template <std::size_t N>
+        constexpr Table makeTable(const Offset (&offsets)[N])
+        {
+            Table table{};
+            for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+            {
+                for (const Offset &o : offsets)
+                {
+                    const Square to = Squares::fromCell(Squares::rowOf(sq) + o.dr,
+                                                        Squares::colOf(sq) + o.dc);
+                    if (to != NO_SQUARE)
+                        table[sq].set(to);
+                }
+            }
+            return table;
+        }
+
+        constexpr Table makeRayTable(const Offset &d)
+        {
+            Table table{};
+            for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+            {
+                int r = Squares::rowOf(sq) + d.dr;
+                int c = Squares::colOf(sq) + d.dc;
+                for (Square to = Squares::fromCell(r, c); to != NO_SQUARE; to = Squares::fromCell(r, c))
+                {
+                    table[sq].set(to);
+                    r += d.dr;
+                    c += d.dc;
+                }
+            }
+            return table;
+        }
+
+        constexpr std::array<Table, 8> makeRays()
+        {
+            std::array<Table, 8> rays{};
+            for (int dir = 0; dir < 8; ++dir)
+                rays[dir] = makeRayTable(RAY_DIRECTIONS[dir]);
+            return rays;
+        }
+    }
+
+    inline constexpr Table KNIGHT     = detail::makeTable(detail::KNIGHT);
+    inline constexpr Table KING       = detail::makeTable(detail::KING);
+    inline constexpr Table CHAMPION   = detail::makeTable(detail::CHAMPION);
+    inline constexpr Table WIZARD     = detail::makeTable(detail::WIZARD);
+    inline constexpr Table WHITE_PAWN = detail::makeTable(detail::WHITE_PAWN);
+    inline constexpr Table BLACK_PAWN = detail::makeTable(detail::BLACK_PAWN);
+
+    // Индексы направлений в RAYS
+    enum Direction : int
+    {
+        South = 0, East = 1, SouthEast = 2, SouthWest = 3,   // индексы растут
+        North = 4, West = 5, NorthWest = 6, NorthEast = 7    // индексы убывают
+    };
+
+    inline constexpr std::array<Table, 8> RAYS = detail::makeRays();
+
+    // Атаки по одному лучу с учётом первой занятой клетки
+    inline Bitboard ray(int dir, Square sq, const Bitboard &occupied) noexcept
+    {
+        const Bitboard &line     = RAYS[dir][sq];
+        const Bitboard  blockers = line & occupied;
+        if (blockers.empty())
+            return line;
+
+        const Square blocker = (dir < North) ? blockers.lsb() : blockers.msb();
+        return line ^ RAYS[dir][blocker];
+    }
+
+    // Клетки строго между a и b, если они на одной линии (иначе пусто)
+    inline Bitboard between(Square a, Square b) noexcept
+    {
+        for (int dir = 0; dir < 8; ++dir)
+        {
+            if (RAYS[dir][a].test(b))
+                return RAYS[dir][a] ^ RAYS[dir][b] ^ Bitboard::fromSquare(b);
+        }
+        return Bitboard();
+    }
+
+    inline Bitboard rook(Square sq, const Bitboard &occupied) noexcept
+    {
+        return ray(South, sq, occupied) | ray(East, sq, occupied) |
+               ray(North, sq, occupied) | ray(West, sq, occupied);
+    }
+
+    inline Bitboard bishop(Square sq, const Bitboard &occupied) noexcept
+    {
+        return ray(SouthEast, sq, occupied) | ray(SouthWest, sq, occupied) |
+               ray(NorthWest, sq, occupied) | ray(NorthEast, sq, occupied);
+    }
+
+    inline Bitboard queen(Square sq, const Bitboard &occupied) noexcept
+    {
+        return rook(sq, occupied) | bishop(sq, occupied);
+    }
+
+    // Клетки, которые бьёт пешка цвета color с клетки sq
+    constexpr Bitboard pawn(PieceColor color, Square sq) noexcept
+    {
+        return color == PieceColor::White ? WHITE_PAWN[sq] : BLACK_PAWN[sq];
+    }
+
+    /**
+     * Атаки прыгающей фигуры kind цвета color с клетки sq.
+     * Для скользящих фигур и пустого типа — пустое множество
+     * (см. attacks()).
+     */
+    constexpr Bitboard leaper(PieceKind kind, PieceColor color, Square sq) noexcept
+    {
+        switch (kind)
+        {
+        case PieceKind::Knight:   return KNIGHT[sq];
+        case PieceKind::King:     return KING[sq];
+        case PieceKind::Champion: return CHAMPION[sq];
+        case PieceKind::Wizard:   return WIZARD[sq];
+        case PieceKind::Pawn:     return pawn(color, sq);
+        default:                  return Bitboard();
+        }
+    }
+
+    // Атаки любой фигуры kind цвета color с клетки sq при занятости occupied
+    inline Bitboard attacks(PieceKind kind, PieceColor color, Square sq, const Bitboard &occupied) noexcept
+    {
+        switch (kind)
+        {
+        case PieceKind::Rook:   return rook(sq, occupied);
+        case PieceKind::Bishop: return bishop(sq, occupied);
+        case PieceKind::Queen:  return queen(sq, occupied);
+        default:                return leaper(kind, color, sq);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Square.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * Множество клеток Omega-доски: 104 бита в двух 64-битных словах.
+ *
+ *  - lo: клетки 0..63
+ *  - hi: клетки 64..103 (старшие 24 бита всегда нулевые)
+ *
+ * Нумерация клеток — см. Square.hpp.
+ */
+struct Bitboard
+{
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    static constexpr std::uint64_t HI_MASK = (std::uint64_t{1} << (SQUARE_COUNT - 64)) - 1;
+
+    constexpr Bitboard() = default;
+    constexpr Bitboard(std::uint64_t low, std::uint64_t high) : lo(low), hi(high) {}
+
+    static constexpr Bitboard fromSquare(Square sq) noexcept
+    {
+        return sq < 64 ? Bitboard(std::uint64_t{1} << sq, 0)
+                       : Bitboard(0, std::uint64_t{1} << (sq - 64));
+    }
+
+    /// Все 104 валидные клетки
+    static constexpr Bitboard all() noexcept
+    {
+        return Bitboard(~std::uint64_t{0}, HI_MASK);
+    }
+
+    constexpr bool test(Square sq) const noexcept
+    {
+        return sq < 64 ? ((lo >> sq) & 1u) != 0
+                       : ((hi >> (sq - 64)) & 1u) != 0;
+    }
+
+    constexpr void set(Square sq) noexcept
+    {
+        if (sq < 64) lo |= std::uint64_t{1} << sq;
+        else         hi |= std::uint64_t{1} << (sq - 64);
+    }
+
+    constexpr void reset(Square sq) noexcept
+    {
+        if (sq < 64) lo &= ~(std::uint64_t{1} << sq);
+        else         hi &= ~(std::uint64_t{1} << (sq - 64));
+    }
+
+    constexpr bool any()   const noexcept { return (lo | hi) != 0; }
+    constexpr bool empty() const noexcept { return (lo | hi) == 0; }
+
+    int popcount() const noexcept { return popcount64(lo) + popcount64(hi); }
+
+    /// Младшая занятая клетка; множество не должно быть пустым
+    Square lsb() const noexcept
+    {
+        return lo ? lsb64(lo) : 64 + lsb64(hi);
+    }
+
+    /// Старшая занятая клетка; множество не должно быть пустым
+    Square msb() const noexcept
+    {
+        return hi ? 64 + msb64(hi) : msb64(lo);
+    }
+
+    /// Извлечь и удалить младшую клетку
+    Square popLsb() noexcept
+    {
+        if (lo)
+        {
+            const Square sq = lsb64(lo);
+            lo &= lo - 1;
+            return sq;
+        }
+        const Square sq = 64 + lsb64(hi);
+        hi &= hi - 1;
+        return sq;
+    }
+
+    constexpr Bitboard operator&(const Bitboard &o) const noexcept { return Bitboard(lo & o.lo, hi & o.hi); }
+    constexpr Bitboard operator|(const Bitboard &o) const noexcept { return Bitboard(lo | o.lo, hi | o.hi); }
+    constexpr Bitboard operator^(const Bitboard &o) const noexcept { return Bitboard(lo ^ o.lo, hi ^ o.hi); }
+    constexpr Bitboard operator~() const noexcept { return Bitboard(~lo, ~hi & HI_MASK); }
+
+    constexpr Bitboard &operator&=(const Bitboard &o) noexcept { lo &= o.lo; hi &= o.hi; return *this; }
+    constexpr Bitboard &operator|=(const Bitboard &o) noexcept { lo |= o.lo; hi |= o.hi; return *this; }
+    constexpr Bitboard &operator^=(const Bitboard &o) noexcept { lo ^= o.lo; hi ^= o.hi; return *this; }
+
+    constexpr bool operator==(const Bitboard &o) const noexcept { return lo == o.lo && hi == o.hi; }
+    constexpr bool operator!=(const Bitboard &o) const noexcept { return !(*this == o); }
+
+private:
+#if defined(_MSC_VER) && !defined(__clang__)
+    static int popcount64(std::uint64_t x) noexcept { return static_cast<int>(__popcnt64(x)); }
+    static int lsb64(std::uint64_t x) noexcept { unsigned long i; _BitScanForward64(&i, x); return static_cast<int>(i); }
+    static int msb64(std::uint64_t x) noexcept { unsigned long i; _BitScanReverse64(&i, x); return static_cast<int>(i); }
+#else
+    static int popcount64(std::uint64_t x) noexcept { return __builtin_popcountll(x); }
+    static int lsb64(std::uint64_t x) noexcept { return __builtin_ctzll(x); }
+    static int msb64(std::uint64_t x) noexcept { return 63 - __builtin_clzll(x); }
+#endif
+};
@@ -1,4 +1,7 @@
 #include "Board.hpp"
+#include "Zobrist.hpp"
+
+#include <cassert>
 #include <stdexcept>
 
 Board::Board()
@@ -18,6 +21,27 @@ void Board::clear()
             m_cells[r][c] = Piece::empty();
         }
     }
+
+    m_occupied = Bitboard();
+    for (Bitboard &bb : m_byColor)
+        bb = Bitboard();
+    for (Bitboard &bb : m_byKind)
+        bb = Bitboard();
+
+    for (auto &counts : m_pieceCount)
+        for (std::uint8_t &n : counts)
+            n = 0;
+    for (Square &sq : m_kingSquare)
+        sq = NO_SQUARE;
+
+    m_sideToMove     = PieceColor::White;
+    m_castlingRights = NoCastling;
+    m_hash           = 0;
+    m_pawnHash       = 0;
+    m_halfmoveClock  = 0;
+
+    m_psqt  = Psqt::Score();
+    m_phase = 0;
 }
 
 /**
@@ -25,35 +49,19 @@ void Board::clear()
  */
 bool Board::isInsideArray(int row, int col) const noexcept
 {
-    return row >= 0 && row < ROWS &&
-           col >= 0 && col < COLS;
+    return Squares::isInsideArray(row, col);
 }
 
 /**
  * Валидные клетки Omega-доски:
  *  - основное поле 10×10: row = 1..10, col = 1..10
  *  - 4 угла: (0,0), (0,11), (11,0), (11,11)
+ *
+ * Проверка — одно чтение из предвычисленной таблицы Squares::CELL_TO_SQUARE.
  */
 bool Board::isValidCell(int row, int col) const noexcept
 {
-    if (!isInsideArray(row, col))
-        return false;
-
-    // основное поле 10×10
-    if (row >= 1 && row <= 10 &&
-        col >= 1 && col <= 10)
-    {
-        return true;
-    }
-
-    // четыре угловые клетки
-    if ((row == 0 || row == ROWS - 1) &&
-        (col == 0 || col == COLS - 1))
-    {
-        return true;
-    }
-
-    return false;
+    return Squares::fromCell(row, col) != NO_SQUARE;
 }
 
 const Piece& Board::pieceAt(int row, int col) const
@@ -63,25 +71,217 @@ const Piece& Board::pieceAt(int row, int col) const
     return m_cells[row][col];
 }
 
-Piece& Board::pieceAt(int row, int col)
+/**
+ * Быстрый доступ по индексу валидной клетки (без проверки границ).
+ */
+const Piece& Board::pieceAt(Square sq) const noexcept
 {
-    if (!isInsideArray(row, col))
-        throw std::out_of_range("Board::pieceAt: index out of range");
-    return m_cells[row][col];
+    return m_cells[Squares::rowOf(sq)][Squares::colOf(sq)];
 }
 
 void Board::setPieceAt(int row, int col, const Piece& piece)
 {
     if (!isInsideArray(row, col))
         throw std::out_of_range("Board::setPieceAt: index out of range");
-    m_cells[row][col] = piece;
+
+    const Square sq = Squares::fromCell(row, col);
+    if (sq == NO_SQUARE)
+    {
+        // Клетка массива вне игрового поля: битборды её не покрывают
+        m_cells[row][col] = piece;
+        return;
+    }
+
+    const PieceKind oldKind = pieceAt(sq).kind;
+
+    removePiece(sq);
+    putPiece(sq, piece);
+
+    if (oldKind == PieceKind::King || oldKind == PieceKind::Rook ||
+        piece.kind == PieceKind::King || piece.kind == PieceKind::Rook)
+    {
+        updateCastlingRights();
+    }
 }
 
 void Board::clearCell(int row, int col)
 {
     if (!isInsideArray(row, col))
         return;
-    m_cells[row][col] = Piece::empty();
+
+    const Square sq = Squares::fromCell(row, col);
+    if (sq == NO_SQUARE)
+    {
+        m_cells[row][col] = Piece::empty();
+        return;
+    }
+
+    const PieceKind oldKind = pieceAt(sq).kind;
+    removePiece(sq);
+
+    if (oldKind == PieceKind::King || oldKind == PieceKind::Rook)
+        updateCastlingRights();
+}
+
+/**
+ * Поставить фигуру на пустую валидную клетку (массив + битборды).
+ */
+void Board::putPiece(Square sq, const Piece& piece) noexcept
+{
+    m_cells[Squares::rowOf(sq)][Squares::colOf(sq)] = piece;
+
+    if (piece.isEmpty())
+        return;
+
+    const Bitboard bit = Bitboard::fromSquare(sq);
+    m_occupied |= bit;
+    m_byColor[static_cast<int>(piece.color)] |= bit;
+    m_byKind[static_cast<int>(piece.kind)]   |= bit;
+    ++m_pieceCount[static_cast<int>(piece.color)][static_cast<int>(piece.kind)];
+
+    m_hash ^= Zobrist::piece(piece.color, piece.kind, sq);
+    if (piece.kind == PieceKind::Pawn)
+        m_pawnHash ^= Zobrist::piece(piece.color, piece.kind, sq);
+
+    m_psqt  += Psqt::value(piece.color, piece.kind, sq);
+    m_phase += Psqt::phaseWeight(piece.kind);
+
+    if (piece.kind == PieceKind::King)
+        updateKingSquare(piece.color);
+}
+
+/**
+ * Убрать фигуру с валидной клетки (массив + битборды).
+ */
+void Board::removePiece(Square sq) noexcept
+{
+    Piece &cell = m_cells[Squares::rowOf(sq)][Squares::colOf(sq)];
+    const Piece old = cell;
+    cell = Piece::empty();
+
+    if (old.isEmpty())
+        return;
+
+    const Bitboard bit = Bitboard::fromSquare(sq);
+    m_occupied ^= bit;
+    m_byColor[static_cast<int>(old.color)] ^= bit;
+    m_byKind[static_cast<int>(old.kind)]   ^= bit;
+    --m_pieceCount[static_cast<int>(old.color)][static_cast<int>(old.kind)];
+
+    m_hash ^= Zobrist::piece(old.color, old.kind, sq);
+    if (old.kind == PieceKind::Pawn)
+        m_pawnHash ^= Zobrist::piece(old.color, old.kind, sq);
+
+    m_psqt  -= Psqt::value(old.color, old.kind, sq);
+    m_phase -= Psqt::phaseWeight(old.kind);
+
+    if (old.kind == PieceKind::King)
+        updateKingSquare(old.color);
+}
+
+void Board::updateKingSquare(PieceColor color) noexcept
+{
+    const Bitboard kings = pieces(color, PieceKind::King);
+    m_kingSquare[static_cast<int>(color)] = kings.any() ? kings.lsb() : NO_SQUARE;
+}
+
+void Board::setSideToMove(PieceColor color) noexcept
+{
+    if (color == m_sideToMove)
+        return;
+
+    m_sideToMove = color;
+    m_hash ^= Zobrist::side();
+}
+
+/**
+ * Права на рокировку по текущей расстановке: король не ходил и на его
+ * горизонтали с нужной стороны есть своя не ходившая ладья.
+ */
+int Board::computeCastlingRights() const noexcept
+{
+    int rights = NoCastling;
+
+    const PieceColor colors[] = {PieceColor::White, PieceColor::Black};
+    for (PieceColor color : colors)
+    {
+        const Square kingSq = kingSquare(color);
+        if (kingSq == NO_SQUARE || pieceAt(kingSq).hasMoved)
+            continue;
+
+        const int kingRow = Squares::rowOf(kingSq);
+        const int kingCol = Squares::colOf(kingSq);
+        const int kingSide  = (color == PieceColor::White) ? WhiteKingSide  : BlackKingSide;
+        const int queenSide = (color == PieceColor::White) ? WhiteQueenSide : BlackQueenSide;
+
+        Bitboard rooks = pieces(color, PieceKind::Rook);
+        while (rooks.any())
+        {
+            const Square sq = rooks.popLsb();
+            if (Squares::rowOf(sq) != kingRow || pieceAt(sq).hasMoved)
+                continue;
+
+            rights |= (Squares::colOf(sq) > kingCol) ? kingSide : queenSide;
+        }
+    }
+
+    return rights;
+}
+
+void Board::updateCastlingRights() noexcept
+{
+    const int rights = computeCastlingRights();
+    m_hash ^= Zobrist::castling(m_castlingRights) ^ Zobrist::castling(rights);
+    m_castlingRights = static_cast<std::uint8_t>(rights);
+}
+
+std::uint64_t Board::computeHash() const noexcept
+{
+    std::uint64_t key = 0;
+
+    Bitboard occ = m_occupied;
+    while (occ.any())
+    {
+        const Square sq = occ.popLsb();
+        const Piece &p = pieceAt(sq);
+        key ^= Zobrist::piece(p.color, p.kind, sq);
+    }
+
+    key ^= Zobrist::castling(computeCastlingRights());
+    if (m_sideToMove == PieceColor::Black)
+        key ^= Zobrist::side();
+
+    return key;
+}
+
+std::uint64_t Board::computePawnHash() const noexcept
+{
+    std::uint64_t key = 0;
+
+    const PieceColor colors[] = {PieceColor::White, PieceColor::Black};
+    for (PieceColor color : colors)
+    {
+        Bitboard pawns = pieces(color, PieceKind::Pawn);
+        while (pawns.any())
+            key ^= Zobrist::piece(color, PieceKind::Pawn, pawns.popLsb());
+    }
+
+    return key;
+}
+
+Psqt::Score Board::computePsqt() const noexcept
+{
+    Psqt::Score score;
+
+    Bitboard occ = m_occupied;
+    while (occ.any())
+    {
+        const Square sq = occ.popLsb();
+        const Piece &p = pieceAt(sq);
+        score += Psqt::value(p.color, p.kind, sq);
+    }
+
+    return score;
 }
 
 bool Board::isEmpty(int row, int col) const
@@ -91,6 +291,129 @@ bool Board::isEmpty(int row, int col) const
     return m_cells[row][col].isEmpty();
 }
 
+/**
+ * Применение заранее проверенного хода.
+ *
+ * Рокировка: король уже стоит в двух клетках от исходной, ладья —
+ * первая фигура на линии в сторону хода; она ставится рядом с королём
+ * с другой стороны.
+ *
+ * В undo сохраняется всё, что нужно unmakeMove для отката за O(1).
+ */
+void Board::makeMove(PackedMove move, UndoInfo &undo)
+{
+    const Square from = move.from();
+    const Square to   = move.to();
+
+    Piece moving = pieceAt(from);
+
+    undo.captured       = pieceAt(to);
+    undo.moverHadMoved  = moving.hasMoved;
+    undo.rookFrom       = static_cast<std::int8_t>(NO_SQUARE);
+    undo.rookTo         = static_cast<std::int8_t>(NO_SQUARE);
+    undo.castlingRights = m_castlingRights;
+    undo.hash           = m_hash;
+    undo.halfmoveClock  = m_halfmoveClock;
+
+    if (move.isCastling())
+    {
+        const int row   = Squares::rowOf(from);
+        const int toCol = Squares::colOf(to);
+        const int dir   = (toCol > Squares::colOf(from)) ? 1 : -1;
+
+        // Ладья — первая фигура за королём в сторону рокировки. Поиск не
+        // выходит за вертикали 1..10: isEmpty вне доски тоже true, и ход
+        // с флагом рокировки без ладьи иначе искал бы её бесконечно
+        int rookCol = Squares::colOf(from) + dir;
+        while (rookCol >= 1 && rookCol <= 10 && isEmpty(row, rookCol))
+            rookCol += dir;
+        assert(rookCol >= 1 && rookCol <= 10 && pieceAt(row, rookCol).kind == PieceKind::Rook);
+
+        const Square rookFrom = Squares::fromCell(row, rookCol);
+        const Square rookTo   = Squares::fromCell(row, toCol - dir);
+        undo.rookFrom = static_cast<std::int8_t>(rookFrom);
+        undo.rookTo   = static_cast<std::int8_t>(rookTo);
+
+        removePiece(from);
+        moving.hasMoved = true;
+        putPiece(to, moving);
+
+        Piece rook = pieceAt(rookFrom);
+        removePiece(rookFrom);
+        rook.hasMoved = true;
+        putPiece(rookTo, rook);
+    }
+    else
+    {
+        removePiece(to);
+        removePiece(from);
+        moving.hasMoved = true;
+        putPiece(to, moving);
+    }
+
+    // Права на рокировку меняются только при ходе короля/ладьи или взятии ладьи
+    if (moving.kind == PieceKind::King || moving.kind == PieceKind::Rook ||
+        undo.captured.kind == PieceKind::Rook)
+    {
+        updateCastlingRights();
+    }
+
+    // Взятие и ход пешки необратимы — счётчик правила 50 ходов сначала
+    if (moving.kind == PieceKind::Pawn || !undo.captured.isEmpty())
+        m_halfmoveClock = 0;
+    else
+        ++m_halfmoveClock;
+
+    m_sideToMove = (m_sideToMove == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+    m_hash ^= Zobrist::side();
+
+    assert(m_hash == computeHash());
+    assert(m_pawnHash == computePawnHash());
+    assert(m_psqt == computePsqt());
+}
+
+void Board::makeMove(PackedMove move)
+{
+    UndoInfo undo;
+    makeMove(move, undo);
+}
+
+/**
+ * Откат хода, выполненного makeMove(move, undo).
+ */
+void Board::unmakeMove(PackedMove move, const UndoInfo &undo)
+{
+    m_sideToMove = (m_sideToMove == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+
+    const Square from = move.from();
+    const Square to   = move.to();
+
+    if (move.isCastling())
+    {
+        // Ладья до рокировки не ходила (иначе рокировка невозможна)
+        Piece rook = pieceAt(undo.rookTo);
+        removePiece(undo.rookTo);
+        rook.hasMoved = false;
+        putPiece(undo.rookFrom, rook);
+    }
+
+    Piece moving = pieceAt(to);
+    removePiece(to);
+    moving.hasMoved = undo.moverHadMoved;
+    putPiece(from, moving);
+
+    if (!undo.captured.isEmpty())
+        putPiece(to, undo.captured);
+
+    m_castlingRights = undo.castlingRights;
+    m_hash           = undo.hash;
+    m_halfmoveClock  = undo.halfmoveClock;
+
+    assert(m_hash == computeHash());
+    assert(m_pawnHash == computePawnHash());
+    assert(m_psqt == computePsqt());
+}
+
 /**
  * Сброс к начальной позиции Omega Chess.
  */
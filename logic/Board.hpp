@@ -1,6 +1,27 @@
 #pragma once
 
 #include "Piece.hpp"
+#include "Square.hpp"
+#include "Bitboard.hpp"
+#include "Move.hpp"
+#include "Psqt.hpp"
+
+/**
+ * Запись для отката хода (Board::unmakeMove).
+ */
+struct UndoInfo
+{
+    Piece captured;              // взятая фигура (или пустая)
+    bool  moverHadMoved = false; // hasMoved походившей фигуры до хода
+
+    std::uint8_t  castlingRights = 0; // права на рокировку до хода
+    std::uint64_t hash           = 0; // ключ Zobrist до хода
+    std::uint16_t halfmoveClock  = 0; // счётчик полуходов без взятий и ходов пешек до хода
+
+    // Рокировка: откуда ушла и куда встала ладья
+    std::int8_t rookFrom = static_cast<std::int8_t>(NO_SQUARE);
+    std::int8_t rookTo   = static_cast<std::int8_t>(NO_SQUARE);
+};
 
 /**
  * Модель доски Омега-шахмат.
@@ -9,12 +30,38 @@
  * Валидные клетки:
  *  - 10x10: row = 1..10, col = 1..10
  *  - углы: (0,0), (0,11), (11,0), (11,11)
+ *
+ * Параллельно массиву поддерживаются битборды (см. Bitboard.hpp)
+ * по цветам и типам фигур, число фигур каждого вида и клетки королей —
+ * их обновляют setPieceAt/clearCell/clear и make/unmake, поэтому запросы
+ * занятости сводятся к паре логических операций, а перебор фигур стороны
+ * идёт по битборду без просмотра пустых клеток.
+ *
+ * Доска также хранит сторону, которой принадлежит ход, права на рокировку
+ * и ключ Zobrist позиции (см. Zobrist.hpp), обновляемый при каждом
+ * изменении клеток и при make/unmake, и отдельный ключ одних только
+ * пешек (для кэша пешечной структуры). Так же инкрементально ведутся
+ * сумма таблиц «фигура–клетка» с материалом и фаза партии (Psqt.hpp).
  */
 class Board
 {
 public:
-    static constexpr int ROWS = 12;
-    static constexpr int COLS = 12;
+    static constexpr int ROWS = Squares::ARRAY_ROWS;
+    static constexpr int COLS = Squares::ARRAY_COLS;
+
+    /**
+     * Права на рокировку. «Королевский» фланг — в сторону больших col.
+     * Право есть, пока король не ходил и на его горизонтали с этой
+     * стороны стоит своя не ходившая ладья.
+     */
+    enum CastlingRight : std::uint8_t
+    {
+        NoCastling     = 0,
+        WhiteKingSide  = 1,
+        WhiteQueenSide = 2,
+        BlackKingSide  = 4,
+        BlackQueenSide = 8
+    };
 
     Board();
     ~Board() = default;
@@ -25,15 +72,100 @@ public:
     bool isValidCell(int row, int col) const noexcept;
 
     const Piece& pieceAt(int row, int col) const;
-    Piece&       pieceAt(int row, int col);
+    const Piece& pieceAt(Square sq) const noexcept;
 
     void setPieceAt(int row, int col, const Piece& piece);
     void clearCell(int row, int col);
     bool isEmpty(int row, int col) const;
     void clear();
 
+    PieceColor sideToMove() const noexcept { return m_sideToMove; }
+    void       setSideToMove(PieceColor color) noexcept;
+
+    int castlingRights() const noexcept { return m_castlingRights; }
+
+    // Полуходы с последнего взятия или хода пешки (правило 50 ходов);
+    // позиции раньше этого момента повториться уже не могут
+    int  halfmoveClock() const noexcept { return m_halfmoveClock; }
+    void setHalfmoveClock(int plies) noexcept { m_halfmoveClock = static_cast<std::uint16_t>(plies); }
+
+    // Ключ Zobrist текущей позиции (фигуры, права на рокировку, сторона хода)
+    std::uint64_t hash() const noexcept { return m_hash; }
+
+    // Тот же ключ, посчитанный с нуля — для проверки инкрементального
+    std::uint64_t computeHash() const noexcept;
+
+    // Ключ Zobrist одних пешек: XOR тех же ключей фигур, что и в hash()
+    std::uint64_t pawnHash() const noexcept { return m_pawnHash; }
+    std::uint64_t computePawnHash() const noexcept;
+
+    // Материал + PSQT всех фигур (mg/eg) с точки зрения белых
+    Psqt::Score psqt() const noexcept { return m_psqt; }
+    // Фаза партии: Psqt::PHASE_MAX — начало, 0 — только пешки и короли
+    int phase() const noexcept { return m_phase; }
+
+    // То же, посчитанное с нуля — для проверки инкрементального
+    Psqt::Score computePsqt() const noexcept;
+
+    /**
+     * Выполнить ход без каких-либо проверок правил и передать ход
+     * сопернику. Ход должен быть заранее проверен (Rules / MoveGen).
+     * Для отката заполняется undo.
+     */
+    void makeMove(PackedMove move, UndoInfo &undo);
+    void makeMove(PackedMove move);
+
+    // Откатить ход, выполненный makeMove(move, undo)
+    void unmakeMove(PackedMove move, const UndoInfo &undo);
+
+    // --- Битборды ---
+    Bitboard occupied() const noexcept { return m_occupied; }
+    Bitboard pieces(PieceColor color) const noexcept { return m_byColor[static_cast<int>(color)]; }
+    Bitboard pieces(PieceKind kind) const noexcept { return m_byKind[static_cast<int>(kind)]; }
+    Bitboard pieces(PieceColor color, PieceKind kind) const noexcept
+    {
+        return m_byColor[static_cast<int>(color)] & m_byKind[static_cast<int>(kind)];
+    }
+
+    int pieceCount(PieceColor color, PieceKind kind) const noexcept
+    {
+        return m_pieceCount[static_cast<int>(color)][static_cast<int>(kind)];
+    }
+
+    // Клетка короля цвета color или NO_SQUARE (если королей несколько — младшая)
+    Square kingSquare(PieceColor color) const noexcept
+    {
+        return m_kingSquare[static_cast<int>(color)];
+    }
+
 private:
+    static constexpr int COLOR_COUNT = 3;   // None, White, Black
+    static constexpr int KIND_COUNT  = 9;   // None .. Wizard
+
     Piece m_cells[ROWS][COLS];
 
+    Bitboard m_occupied;
+    Bitboard m_byColor[COLOR_COUNT];
+    Bitboard m_byKind[KIND_COUNT];
+
+    std::uint8_t m_pieceCount[COLOR_COUNT][KIND_COUNT];
+    Square       m_kingSquare[COLOR_COUNT];
+
+    PieceColor    m_sideToMove     = PieceColor::White;
+    std::uint8_t  m_castlingRights = NoCastling;
+    std::uint64_t m_hash           = 0;
+    std::uint64_t m_pawnHash       = 0;
+    std::uint16_t m_halfmoveClock  = 0;
+
+    Psqt::Score m_psqt;
+    int         m_phase = 0;
+
+    void putPiece(Square sq, const Piece& piece) noexcept;
+    void removePiece(Square sq) noexcept;
+    void updateKingSquare(PieceColor color) noexcept;
+
+    int  computeCastlingRights() const noexcept;
+    void updateCastlingRights() noexcept;
+
     void setupInitialPieces();
 };
@@ -0,0 +1,348 @@
+#include "Fen.hpp"
+
+#include <cstring>
+
+namespace
+{
+    constexpr int PLACEMENT_LINES      = 12;   // угол чёрных, 10 горизонталей, угол белых
+    constexpr int WHITE_PAWN_START_ROW = 9;
+    constexpr int BLACK_PAWN_START_ROW = 2;
+
+    // Строка расстановки → строка массива; клетка строки → столбец
+    int lineWidth(int line) noexcept
+    {
+        return (line == 0 || line == PLACEMENT_LINES - 1) ? 2 : 10;
+    }
+
+    int columnOf(int line, int index) noexcept
+    {
+        if (lineWidth(line) == 2)
+            return index == 0 ? 0 : Squares::ARRAY_COLS - 1;
+        return index + 1;
+    }
+
+    PieceKind kindFromChar(char ch) noexcept
+    {
+        switch (ch)
+        {
+            case 'k': return PieceKind::King;
+            case 'q': return PieceKind::Queen;
+            case 'r': return PieceKind::Rook;
+            case 'b': return PieceKind::Bishop;
+            case 'n': return PieceKind::Knight;
+            case 'p': return PieceKind::Pawn;
+            case 'c': return PieceKind::Champion;
+            case 'w': return PieceKind::Wizard;
+            default:  return PieceKind::None;
+        }
+    }
+
+    char charFromKind(PieceKind kind) noexcept
+    {
+        switch (kind)
+        {
+            case PieceKind::King:     return 'k';
+            case PieceKind::Queen:    return 'q';
+            case PieceKind::Rook:     return 'r';
+            case PieceKind::Bishop:   return 'b';
+            case PieceKind::Knight:   return 'n';
+            case PieceKind::Pawn:     return 'p';
+            case PieceKind::Champion: return 'c';
+            case PieceKind::Wizard:   return 'w';
+            default:                  return '?';
+        }
+    }
+
+    // Фигур каждого вида не больше, чем в начальной расстановке: пешки не
+    // превращаются, и набор фигур может только убывать. Без этой границы
+    // запись с десятками ферзей переполнила бы MoveList
+    int maxCount(PieceKind kind) noexcept
+    {
+        switch (kind)
+        {
+            case PieceKind::King:
+            case PieceKind::Queen:    return 1;
+            case PieceKind::Pawn:     return 10;
+            default:                  return 2;
+        }
+    }
+
+    char toUpper(char ch) noexcept { return static_cast<char>(ch - 'a' + 'A'); }
+    char toLower(char ch) noexcept { return static_cast<char>(ch - 'A' + 'a'); }
+
+    // Число пустых клеток подряд (0 — ничего не пишется)
+    void appendEmpty(char *out, std::size_t &n, int empty) noexcept
+    {
+        if (empty == 10)
+        {
+            out[n++] = '1';
+            out[n++] = '0';
+        }
+        else if (empty > 0)
+        {
+            out[n++] = static_cast<char>('0' + empty);
+        }
+    }
+
+    // Следующее поле, разделённое пробелами; пустое — поля кончились
+    std::string_view nextField(std::string_view &rest) noexcept
+    {
+        std::size_t begin = 0;
+        while (begin < rest.size() && rest[begin] == ' ')
+            ++begin;
+
+        std::size_t end = begin;
+        while (end < rest.size() && rest[end] != ' ')
+            ++end;
+
+        const std::string_view field = rest.substr(begin, end - begin);
+        rest.remove_prefix(end);
+        return field;
+    }
+
+    bool parseCastling(std::string_view field, int &rights) noexcept
+    {
+        rights = Board::NoCastling;
+        if (field == "-")
+            return true;
+        if (field.empty())
+            return false;
+
+        for (char ch : field)
+        {
+            int right = Board::NoCastling;
+            switch (ch)
+            {
+                case 'K': right = Board::WhiteKingSide;  break;
+                case 'Q': right = Board::WhiteQueenSide; break;
+                case 'k': right = Board::BlackKingSide;  break;
+                case 'q': right = Board::BlackQueenSide; break;
+                default:  return false;
+            }
+            if (rights & right)
+                return false;
+            rights |= right;
+        }
+        return true;
+    }
+
+    bool parseClock(std::string_view field, int &clock) noexcept
+    {
+        clock = 0;
+        if (field.empty() || field.size() > 5)
+            return false;
+
+        for (char ch : field)
+        {
+            if (ch < '0' || ch > '9')
+                return false;
+            clock = clock * 10 + (ch - '0');
+        }
+        return clock <= 0xFFFF;
+    }
+
+    bool parsePlacement(std::string_view field, int rights, Board &board)
+    {
+        const bool whiteKingHome = (rights & (Board::WhiteKingSide | Board::WhiteQueenSide)) != 0;
+        const bool blackKingHome = (rights & (Board::BlackKingSide | Board::BlackQueenSide)) != 0;
+
+        int line  = 0;
+        int index = 0;
+
+        // Число фигур по цвету (0 — белые) и виду
+        int counts[2][static_cast<int>(PieceKind::Wizard) + 1] = {};
+
+        for (std::size_t i = 0; i < field.size(); ++i)
+        {
+            const char ch = field[i];
+
+            if (ch == '/')
+            {
+                if (index != lineWidth(line) || ++line >= PLACEMENT_LINES)
+                    return false;
+                index = 0;
+                continue;
+            }
+
+            if (ch >= '1' && ch <= '9')
+            {
+                int run = ch - '0';
+                if (ch == '1' && i + 1 < field.size() && field[i + 1] == '0')
+                {
+                    run = 10;
+                    ++i;
+                }
+                index += run;
+                if (index > lineWidth(line))
+                    return false;
+                continue;
+            }
+
+            const bool white = ch >= 'A' && ch <= 'Z';
+            const PieceKind kind = kindFromChar(white ? toLower(ch) : ch);
+            if (kind == PieceKind::None || index >= lineWidth(line))
+                return false;
+            if (++counts[white ? 0 : 1][static_cast<int>(kind)] > maxCount(kind))
+                return false;
+
+            Piece piece{white ? PieceColor::White : PieceColor::Black, kind, false};
+            const int row = line;
+            if (kind == PieceKind::Pawn)
+                piece.hasMoved = row != (white ? WHITE_PAWN_START_ROW : BLACK_PAWN_START_ROW);
+            else if (kind == PieceKind::King)
+                piece.hasMoved = !(white ? whiteKingHome : blackKingHome);
+            else if (kind == PieceKind::Rook)
+                piece.hasMoved = true;   // нужные для рокировок — ниже
+
+            board.setPieceAt(row, columnOf(line, index), piece);
+            ++index;
+        }
+
+        // Ровно по одному королю у каждой стороны
+        const int king = static_cast<int>(PieceKind::King);
+        return line == PLACEMENT_LINES - 1 && index == lineWidth(line) &&
+               counts[0][king] == 1 && counts[1][king] == 1;
+    }
+
+    // Дальняя от короля своя ладья на его горизонтали со стороны dir
+    // становится «не ходившей»
+    bool restoreCastlingRook(Board &board, PieceColor color, int dir)
+    {
+        const Square king = board.kingSquare(color);
+        if (king == NO_SQUARE)
+            return false;
+
+        const int row     = Squares::rowOf(king);
+        const int kingCol = Squares::colOf(king);
+
+        for (int col = (dir > 0 ? 10 : 1); col != kingCol; col -= dir)
+        {
+            const Piece &p = board.pieceAt(row, col);
+            if (p.kind == PieceKind::Rook && p.color == color)
+            {
+                board.setPieceAt(row, col, Piece{color, PieceKind::Rook, false});
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+namespace Fen
+{
+    bool parse(std::string_view text, Board &board)
+    {
+        board.clear();
+
+        std::string_view rest = text;
+        const std::string_view placement = nextField(rest);
+        const std::string_view side      = nextField(rest);
+        const std::string_view castling  = nextField(rest);
+        const std::string_view clock     = nextField(rest);
+
+        int rights = Board::NoCastling;
+        int plies  = 0;
+
+        bool ok = !placement.empty() &&
+                  (side == "w" || side == "b") &&
+                  parseCastling(castling, rights) &&
+                  (clock.empty() || parseClock(clock, plies)) &&
+                  nextField(rest).empty() &&
+                  parsePlacement(placement, rights, board);
+
+        struct Right { int mask; PieceColor color; int dir; };
+        const Right all[] = {
+            {Board::WhiteKingSide,  PieceColor::White, +1},
+            {Board::WhiteQueenSide, PieceColor::White, -1},
+            {Board::BlackKingSide,  PieceColor::Black, +1},
+            {Board::BlackQueenSide, PieceColor::Black, -1},
+        };
+        for (const Right &r : all)
+        {
+            if (ok && (rights & r.mask))
+                ok = restoreCastlingRook(board, r.color, r.dir);
+        }
+
+        // Заявленные рокировки должны следовать из расстановки
+        if (!ok || board.castlingRights() != rights)
+        {
+            board.clear();
+            return false;
+        }
+
+        board.setSideToMove(side == "w" ? PieceColor::White : PieceColor::Black);
+        board.setHalfmoveClock(plies);
+        return true;
+    }
+
+    std::size_t write(const Board &board, char *buffer, std::size_t size) noexcept
+    {
+        char out[MAX_LENGTH];
+        std::size_t n = 0;
+
+        for (int line = 0; line < PLACEMENT_LINES; ++line)
+        {
+            if (line > 0)
+                out[n++] = '/';
+
+            int empty = 0;
+            for (int index = 0; index < lineWidth(line); ++index)
+            {
+                const Piece &p = board.pieceAt(Squares::fromCell(line, columnOf(line, index)));
+                if (p.isEmpty())
+                {
+                    ++empty;
+                    continue;
+                }
+
+                appendEmpty(out, n, empty);
+                empty = 0;
+
+                const char ch = charFromKind(p.kind);
+                out[n++] = p.color == PieceColor::White ? toUpper(ch) : ch;
+            }
+
+            appendEmpty(out, n, empty);
+        }
+
+        out[n++] = ' ';
+        out[n++] = board.sideToMove() == PieceColor::White ? 'w' : 'b';
+        out[n++] = ' ';
+
+        const int rights = board.castlingRights();
+        if (rights == Board::NoCastling)
+            out[n++] = '-';
+        if (rights & Board::WhiteKingSide)  out[n++] = 'K';
+        if (rights & Board::WhiteQueenSide) out[n++] = 'Q';
+        if (rights & Board::BlackKingSide)  out[n++] = 'k';
+        if (rights & Board::BlackQueenSide) out[n++] = 'q';
+
+        out[n++] = ' ';
+
+        // Счётчик полуходов — не больше 5 цифр
+        char digits[5];
+        int count = 0;
+        unsigned clock = static_cast<unsigned>(board.halfmoveClock());
+        do
+        {
+            digits[count++] = static_cast<char>('0' + clock % 10);
+            clock /= 10;
+        } while (clock > 0);
+        while (count > 0)
+            out[n++] = digits[--count];
+
+        if (n + 1 > size)
+            return 0;
+
+        std::memcpy(buffer, out, n);
+        buffer[n] = '\0';
+        return n;
+    }
+
+    std::string toString(const Board &board)
+    {
+        char buffer[MAX_LENGTH];
+        const std::size_t n = write(board, buffer, sizeof(buffer));
+        return std::string(buffer, n);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+
+/**
+ * Текстовая запись позиции Omega Chess в духе FEN.
+ *
+ *   <расстановка> <сторона> <рокировки> [<полуходы>]
+ *
+ * Расстановка — 12 строк через «/» сверху вниз: угловые клетки чёрных
+ * (w4, w3), горизонтали 9..0 (по 10 клеток, a..j) и угловые клетки
+ * белых (w1, w2). Фигуры — буквы K Q R B N P C (Champion) W (Wizard),
+ * белые заглавными, чёрные строчными; цифры — число пустых клеток
+ * подряд (до 10). Сторона хода — «w» или «b». Рокировки — подмножество
+ * «KQkq» или «-», «K» — в сторону больших col. Полуходы — счётчик
+ * Board::halfmoveClock() (при разборе можно опустить, тогда 0).
+ *
+ * Признак «ходила» восстанавливается так: пешка не ходила, если стоит
+ * на своей начальной горизонтали (назад пешки не ходят), король — если
+ * у его цвета есть рокировка, ладья — если она дальняя от короля ладья
+ * на его горизонтали с той стороны, куда есть рокировка. Остальным
+ * фигурам признак не важен, они считаются не ходившими.
+ *
+ * У каждой стороны ровно один король, а фигур каждого вида не больше,
+ * чем в начальной расстановке (пешки не превращаются); иначе запись
+ * некорректна.
+ *
+ * Разбор и запись не выделяют памяти: разбор читает std::string_view
+ * и пишет прямо в доску, запись идёт в буфер вызывающей стороны.
+ */
+namespace Fen
+{
+    // Начальная позиция (та же, что Board::resetToInitialPosition)
+    constexpr std::string_view START =
+        "ww/crnbqkbnrc/pppppppppp/10/10/10/10/10/10/PPPPPPPPPP/CRNBQKBNRC/WW w KQkq 0";
+
+    // Размер буфера, которого хватает для записи любой позиции (с '\0'):
+    // 104 фигуры, 11 «/» и поля «w KQkq 65535»
+    constexpr std::size_t MAX_LENGTH = 136;
+
+    // Разобрать запись в board. false — запись некорректна (в том числе
+    // заявлена рокировка, которой нет по расстановке); доска тогда очищена
+    bool parse(std::string_view text, Board &board);
+
+    // Записать позицию в buffer с завершающим '\0'. Возвращает длину
+    // без '\0' или 0, если буфер меньше нужного (MAX_LENGTH хватает всегда)
+    std::size_t write(const Board &board, char *buffer, std::size_t size) noexcept;
+
+    // То же в строку — для журналов и тестов
+    std::string toString(const Board &board);
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "Square.hpp"
+
+/// Простейшая координата на доске
+struct Position
+{
+    int row = 0;
+    int col = 0;
+
+    Position() = default;
+    Position(int r, int c) : row(r), col(c) {}
+};
+
+/// Описание хода: из клетки в клетку
+struct Move
+{
+    Position from;
+    Position to;
+};
+
+/**
+ * Компактный ход для генератора: 16 бит.
+ *
+ *  - биты 0..6   — исходная клетка (Square, 0..103)
+ *  - биты 7..13  — целевая клетка
+ *  - биты 14..15 — флаг (обычный ход / рокировка)
+ *
+ * Нулевое значение (0 → 0) — «нет хода»: такой ход невозможен.
+ */
+class PackedMove
+{
+public:
+    enum Flag : std::uint16_t
+    {
+        Normal   = 0,
+        Castling = 1
+    };
+
+    constexpr PackedMove() = default;
+    constexpr PackedMove(Square from, Square to, Flag flag = Normal)
+        : m_data(static_cast<std::uint16_t>(from | (to << 7) | (flag << 14)))
+    {
+    }
+
+    static constexpr PackedMove none() noexcept { return PackedMove(); }
+
+    static constexpr PackedMove fromRaw(std::uint16_t raw) noexcept
+    {
+        PackedMove m;
+        m.m_data = raw;
+        return m;
+    }
+
+    constexpr Square from() const noexcept { return m_data & 0x7F; }
+    constexpr Square to()   const noexcept { return (m_data >> 7) & 0x7F; }
+    constexpr Flag   flag() const noexcept { return static_cast<Flag>(m_data >> 14); }
+
+    constexpr bool isCastling() const noexcept { return flag() == Castling; }
+    constexpr bool isNone()     const noexcept { return m_data == 0; }
+
+    constexpr std::uint16_t raw() const noexcept { return m_data; }
+
+    /// Развернуть в координаты массива 12×12
+    Move toMove() const noexcept
+    {
+        Move m;
+        m.from = Position(Squares::rowOf(from()), Squares::colOf(from()));
+        m.to   = Position(Squares::rowOf(to()),   Squares::colOf(to()));
+        return m;
+    }
+
+    constexpr bool operator==(const PackedMove &o) const noexcept { return m_data == o.m_data; }
+    constexpr bool operator!=(const PackedMove &o) const noexcept { return m_data != o.m_data; }
+
+private:
+    std::uint16_t m_data = 0;
+};
+
+/**
+ * Буфер ходов фиксированной ёмкости (без выделения памяти в куче).
+ * Заводится вызывающей стороной, обычно на стеке.
+ */
+class MoveList
+{
+public:
+    // Без превращения пешек набор фигур фиксирован, и легальных
+    // ходов в позиции заведомо меньше этой границы.
+    static constexpr int CAPACITY = 256;
+
+    void push(PackedMove m) noexcept
+    {
+        assert(m_size < CAPACITY);
+        m_moves[m_size++] = m;
+    }
+    void clear() noexcept { m_size = 0; }
+
+    int  size()  const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    PackedMove  operator[](int i) const noexcept { return m_moves[i]; }
+    PackedMove &operator[](int i) noexcept { return m_moves[i]; }
+
+    const PackedMove *begin() const noexcept { return m_moves; }
+    const PackedMove *end()   const noexcept { return m_moves + m_size; }
+
+    bool contains(PackedMove m) const noexcept
+    {
+        for (int i = 0; i < m_size; ++i)
+        {
+            if (m_moves[i] == m)
+                return true;
+        }
+        return false;
+    }
+
+private:
+    PackedMove m_moves[CAPACITY];
+    int        m_size = 0;
+};
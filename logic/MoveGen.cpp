@@ -0,0 +1,425 @@
+#include "MoveGen.hpp"
+#include "Attacks.hpp"
+#include "Rules.hpp"
+
+namespace
+{
+    constexpr int WHITE_PAWN_START_ROW = 9;
+    constexpr int BLACK_PAWN_START_ROW = 2;
+
+    PieceColor opposite(PieceColor c)
+    {
+        return (c == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+    }
+
+    // Ходы на все клетки множества targets
+    void addMoves(Square from, Bitboard targets, MoveList &moves)
+    {
+        while (targets.any())
+            moves.push(PackedMove(from, targets.popLsb()));
+    }
+
+    // Ходы пешки; allowed ограничивает клетки назначения (проход
+    // многоклеточного хода через запрещённую пустую клетку не мешает)
+    void addPawnMoves(const Board &board, Square from, const Piece &pawn,
+                      const Bitboard &allowed, MoveList &moves)
+    {
+        const int row = Squares::rowOf(from);
+        const int col = Squares::colOf(from);
+
+        const bool white    = (pawn.color == PieceColor::White);
+        const int  dir      = white ? -1 : 1;
+        const int  startRow = white ? WHITE_PAWN_START_ROW : BLACK_PAWN_START_ROW;
+
+        // Тихие ходы: после первого хода — на 1, первый ход — на 1..3
+        // и только с начальной горизонтали
+        int maxSteps = 1;
+        if (!pawn.hasMoved)
+            maxSteps = (row == startRow) ? 3 : 0;
+
+        for (int k = 1; k <= maxSteps; ++k)
+        {
+            const Square to = Squares::fromCell(row + dir * k, col);
+            if (to == NO_SQUARE || !board.pieceAt(to).isEmpty())
+                break;
+            if (allowed.test(to))
+                moves.push(PackedMove(from, to));
+        }
+
+        // Взятия: на одну диагональ вперёд, кроме короля
+        const Bitboard enemies = board.pieces(opposite(pawn.color)) & ~board.pieces(PieceKind::King);
+        addMoves(from, Attacks::pawn(pawn.color, from) & enemies & allowed, moves);
+    }
+
+    void addCastlingMoves(const Board &board, Square from, const Piece &king, MoveList &moves)
+    {
+        if (king.hasMoved)
+            return;
+
+        const int row = Squares::rowOf(from);
+        const int col = Squares::colOf(from);
+        const PieceColor enemy = opposite(king.color);
+
+        for (int dir = -1; dir <= 1; dir += 2)
+        {
+            const Square to = Squares::fromCell(row, col + 2 * dir);
+            if (to == NO_SQUARE || !board.pieceAt(to).isEmpty())
+                continue;
+
+            // Первая фигура на линии — своя ещё не ходившая ладья
+            int c = col + dir;
+            while (board.isValidCell(row, c) && board.isEmpty(row, c))
+                c += dir;
+
+            if (!board.isValidCell(row, c))
+                continue;
+
+            const Piece &rook = board.pieceAt(row, c);
+            if (rook.kind != PieceKind::Rook || rook.color != king.color || rook.hasMoved)
+                continue;
+
+            if (Rules::isSquareAttacked(board, row, col, enemy) ||
+                Rules::isSquareAttacked(board, row, col + dir, enemy) ||
+                Rules::isSquareAttacked(board, row, col + 2 * dir, enemy))
+            {
+                continue;
+            }
+
+            moves.push(PackedMove(from, to, PackedMove::Castling));
+        }
+    }
+}
+
+// Ходы фигуры p с клетки from (без рокировки) на клетки targets
+static void addPieceMoves(const Board &board, Square from, const Piece &p,
+                          const Bitboard &targets, const Bitboard &occupied, MoveList &moves)
+{
+    switch (p.kind)
+    {
+    case PieceKind::Pawn:
+        addPawnMoves(board, from, p, targets, moves);
+        break;
+    case PieceKind::Knight:
+        addMoves(from, Attacks::KNIGHT[from] & targets, moves);
+        break;
+    case PieceKind::King:
+        addMoves(from, Attacks::KING[from] & targets, moves);
+        break;
+    case PieceKind::Champion:
+        addMoves(from, Attacks::CHAMPION[from] & targets, moves);
+        break;
+    case PieceKind::Wizard:
+        addMoves(from, Attacks::WIZARD[from] & targets, moves);
+        break;
+    case PieceKind::Rook:
+        addMoves(from, Attacks::rook(from, occupied) & targets, moves);
+        break;
+    case PieceKind::Bishop:
+        addMoves(from, Attacks::bishop(from, occupied) & targets, moves);
+        break;
+    case PieceKind::Queen:
+        addMoves(from, Attacks::queen(from, occupied) & targets, moves);
+        break;
+    default:
+        break;
+    }
+}
+
+void MoveGen::generatePseudoLegal(const Board &board, MoveList &moves)
+{
+    const PieceColor us = board.sideToMove();
+
+    // Куда можно встать: пустые клетки и чужие фигуры, кроме короля
+    const Bitboard targets  = ~(board.pieces(us) | board.pieces(PieceKind::King));
+    const Bitboard occupied = board.occupied();
+
+    Bitboard own = board.pieces(us);
+    while (own.any())
+    {
+        const Square from = own.popLsb();
+        const Piece &p = board.pieceAt(from);
+
+        addPieceMoves(board, from, p, targets, occupied, moves);
+        if (p.kind == PieceKind::King)
+            addCastlingMoves(board, from, p, moves);
+    }
+}
+
+bool MoveGen::isLegal(Board &board, PackedMove move)
+{
+    const PieceColor us = board.sideToMove();
+
+    UndoInfo undo;
+    board.makeMove(move, undo);
+    const bool legal = !Rules::isKingInCheck(board, us);
+    board.unmakeMove(move, undo);
+    return legal;
+}
+
+// ---------------------------------------------------------------------
+// Легальные ходы
+// ---------------------------------------------------------------------
+
+namespace
+{
+    /**
+     * Что нужно для генерации сразу легальных ходов, посчитанное один
+     * раз на позицию: шахующие фигуры и связанные свои фигуры.
+     * Связка — своя фигура, единственная между королём и чужой
+     * дальнобойной фигурой на линии её хода; ходить ей можно только
+     * по отрезку от короля до связывающей фигуры включительно
+     * (прыгающие фигуры иначе могли бы перескочить её).
+     */
+    struct PinInfo
+    {
+        Bitboard checkers;
+        Bitboard pinned;
+
+        int      pinCount = 0;
+        Square   pinnedSquare[8];
+        Bitboard pinLine[8];
+
+        const Bitboard &lineOf(Square sq) const noexcept
+        {
+            int i = 0;
+            while (pinnedSquare[i] != sq)
+                ++i;
+            return pinLine[i];
+        }
+    };
+
+    bool isOrthogonal(int dir) noexcept
+    {
+        return dir == Attacks::South || dir == Attacks::East ||
+               dir == Attacks::North || dir == Attacks::West;
+    }
+
+    bool isSlider(PieceKind kind) noexcept
+    {
+        return kind == PieceKind::Rook || kind == PieceKind::Bishop || kind == PieceKind::Queen;
+    }
+
+    void computePins(const Board &board, PieceColor us, Square king, PinInfo &info)
+    {
+        const PieceColor them     = opposite(us);
+        const Bitboard   occupied = board.occupied();
+        const Bitboard   ours     = board.pieces(us);
+        const Bitboard   queens   = board.pieces(them, PieceKind::Queen);
+        const Bitboard   rookLike   = board.pieces(them, PieceKind::Rook)   | queens;
+        const Bitboard   bishopLike = board.pieces(them, PieceKind::Bishop) | queens;
+
+        info.checkers = Rules::attackersTo(board, king) & board.pieces(them);
+
+        for (int dir = 0; dir < 8; ++dir)
+        {
+            const bool forward = dir < Attacks::North;
+
+            Bitboard blockers = Attacks::RAYS[dir][king] & occupied;
+            if (blockers.empty())
+                continue;
+
+            const Square first = forward ? blockers.lsb() : blockers.msb();
+            if (!ours.test(first))
+                continue;
+
+            blockers &= Attacks::RAYS[dir][first];
+            if (blockers.empty())
+                continue;
+
+            const Square second = forward ? blockers.lsb() : blockers.msb();
+            const Bitboard &pinners = isOrthogonal(dir) ? rookLike : bishopLike;
+            if (!pinners.test(second))
+                continue;
+
+            info.pinned.set(first);
+            info.pinnedSquare[info.pinCount] = first;
+            info.pinLine[info.pinCount]      = Attacks::RAYS[dir][king] ^ Attacks::RAYS[dir][second];
+            ++info.pinCount;
+        }
+    }
+
+    // Король после хода на to не под ударом (сам король с from снят с доски,
+    // чтобы шахующий луч не «заслонялся» им же)
+    bool kingSafeAt(const Board &board, Square to, const Bitboard &occupied, PieceColor them)
+    {
+        return (Rules::attackersTo(board, to, occupied) & board.pieces(them)).empty();
+    }
+
+    // Рокировка легальна, если король на новой клетке не под ударом
+    // с учётом переставленной ладьи (поле и проход проверены генератором)
+    bool castlingIsLegal(const Board &board, PackedMove move, PieceColor them)
+    {
+        const Square from = move.from();
+        const Square to   = move.to();
+        const int    row  = Squares::rowOf(from);
+        const int    dir  = (Squares::colOf(to) > Squares::colOf(from)) ? 1 : -1;
+
+        int rookCol = Squares::colOf(from) + dir;
+        while (board.isEmpty(row, rookCol))
+            rookCol += dir;
+
+        const Square rookFrom = Squares::fromCell(row, rookCol);
+        const Square rookTo   = Squares::fromCell(row, Squares::colOf(to) - dir);
+
+        Bitboard occupied = board.occupied();
+        occupied.reset(from);
+        occupied.reset(rookFrom);
+        occupied.set(to);
+        occupied.set(rookTo);
+        return kingSafeAt(board, to, occupied, them);
+    }
+
+    /**
+     * Сразу легальные ходы стороны хода (stopAtFirst — до первого
+     * найденного). Позиции без короля или с несколькими королями
+     * сюда не попадают: для них — make/unmake (см. generateLegal).
+     */
+    void addLegalMoves(const Board &board, Square king, MoveList &moves, bool stopAtFirst)
+    {
+        const PieceColor us   = board.sideToMove();
+        const PieceColor them = opposite(us);
+
+        PinInfo info;
+        computePins(board, us, king, info);
+
+        const Bitboard targets  = ~(board.pieces(us) | board.pieces(PieceKind::King));
+        const Bitboard occupied = board.occupied();
+
+        // Король: каждая клетка проверяется на удар без самого короля
+        const Bitboard withoutKing = occupied ^ Bitboard::fromSquare(king);
+        Bitboard kingTargets = Attacks::KING[king] & targets;
+        while (kingTargets.any())
+        {
+            const Square to = kingTargets.popLsb();
+            if (kingSafeAt(board, to, withoutKing, them))
+            {
+                moves.push(PackedMove(king, to));
+                if (stopAtFirst)
+                    return;
+            }
+        }
+
+        // Двойной шах — только ходы короля
+        if (info.checkers.popcount() > 1)
+            return;
+
+        // Под шахом — взять шахующую фигуру или, если она дальнобойная,
+        // встать на линию; прыжки перекрыть нельзя
+        Bitboard evasion = Bitboard::all();
+        if (info.checkers.any())
+        {
+            const Square checker = info.checkers.lsb();
+            evasion = info.checkers;
+            if (isSlider(board.pieceAt(checker).kind))
+                evasion |= Attacks::between(king, checker);
+        }
+
+        Bitboard own = board.pieces(us) ^ Bitboard::fromSquare(king);
+        while (own.any())
+        {
+            const Square from = own.popLsb();
+
+            Bitboard allowed = targets & evasion;
+            if (info.pinned.test(from))
+                allowed &= info.lineOf(from);
+            if (allowed.empty())
+                continue;
+
+            addPieceMoves(board, from, board.pieceAt(from), allowed, occupied, moves);
+            if (stopAtFirst && !moves.empty())
+                return;
+        }
+
+        // Рокировка: под шахом невозможна
+        if (info.checkers.empty())
+        {
+            MoveList castles;
+            addCastlingMoves(board, king, board.pieceAt(king), castles);
+            for (PackedMove m : castles)
+            {
+                if (castlingIsLegal(board, m, them))
+                {
+                    moves.push(m);
+                    if (stopAtFirst)
+                        return;
+                }
+            }
+        }
+    }
+
+    // Ровно один король стороны хода — иначе сокращения неприменимы
+    Square singleKing(const Board &board)
+    {
+        const PieceColor us = board.sideToMove();
+        return board.pieceCount(us, PieceKind::King) == 1 ? board.kingSquare(us) : NO_SQUARE;
+    }
+}
+
+static void filterLegal(Board &board, const MoveList &pseudo, MoveList &moves)
+{
+    for (PackedMove m : pseudo)
+    {
+        if (MoveGen::isLegal(board, m))
+            moves.push(m);
+    }
+}
+
+void MoveGen::generateLegal(const Board &board, MoveList &moves)
+{
+    const Square king = singleKing(board);
+    if (king != NO_SQUARE)
+    {
+        addLegalMoves(board, king, moves, false);
+        return;
+    }
+
+    // Без короля или с несколькими (ручная расстановка) — make/unmake на копии
+    MoveList pseudo;
+    generatePseudoLegal(board, pseudo);
+
+    Board scratch = board;
+    filterLegal(scratch, pseudo, moves);
+}
+
+bool MoveGen::hasLegalMove(const Board &board)
+{
+    const Square king = singleKing(board);
+    if (king == NO_SQUARE)
+    {
+        MoveList legal;
+        generateLegal(board, legal);
+        return !legal.empty();
+    }
+
+    MoveList moves;
+    addLegalMoves(board, king, moves, true);
+    return !moves.empty();
+}
+
+static std::uint64_t perftRecursive(Board &board, int depth)
+{
+    MoveList moves;
+    MoveGen::generateLegal(board, moves);
+
+    if (depth == 1)
+        return static_cast<std::uint64_t>(moves.size());
+
+    std::uint64_t nodes = 0;
+    for (PackedMove m : moves)
+    {
+        UndoInfo undo;
+        board.makeMove(m, undo);
+        nodes += perftRecursive(board, depth - 1);
+        board.unmakeMove(m, undo);
+    }
+    return nodes;
+}
+
+std::uint64_t MoveGen::perft(const Board &board, int depth)
+{
+    if (depth <= 0)
+        return 1;
+
+    Board scratch = board;
+    return perftRecursive(scratch, depth);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * Генератор ходов Omega Chess.
+ *
+ * Заполняет буфер MoveList, выделенный вызывающей стороной, ходами
+ * стороны board.sideToMove(): все фигуры, включая Champion и Wizard,
+ * 1/2/3-клеточные ходы пешек и рокировку. Правила совпадают с Rules
+ * (и, следовательно, с GameController).
+ */
+namespace MoveGen
+{
+    // Псевдолегальные ходы: шаблоны, препятствия, условия рокировки;
+    // без проверки, остаётся ли свой король под шахом
+    void generatePseudoLegal(const Board &board, MoveList &moves);
+
+    // Только легальные ходы. Шахующие и связанные фигуры считаются
+    // один раз: связанные ходят только по линии связки, под шахом —
+    // только уходы; клетки короля проверяются без make/unmake
+    void generateLegal(const Board &board, MoveList &moves);
+
+    // Есть ли у стороны хода хоть один легальный ход (generateLegal до
+    // первого найденного). Нет ходов: под шахом — мат, иначе пат
+    bool hasLegalMove(const Board &board);
+
+    // Псевдолегальный ход не оставляет своего короля под шахом?
+    // Проверка через make/unmake: доска временно меняется и восстанавливается.
+    bool isLegal(Board &board, PackedMove move);
+
+    // Число листьев дерева легальных ходов глубины depth
+    std::uint64_t perft(const Board &board, int depth);
+}
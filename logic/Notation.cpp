@@ -0,0 +1,87 @@
+#include "Notation.hpp"
+#include "MoveGen.hpp"
+
+namespace
+{
+    struct Corner
+    {
+        char   digit;
+        Square square;
+    };
+
+    const Corner CORNERS[] = {
+        {'1', Squares::fromCell(11, 0)},
+        {'2', Squares::fromCell(11, 11)},
+        {'3', Squares::fromCell(0, 11)},
+        {'4', Squares::fromCell(0, 0)},
+    };
+}
+
+namespace Notation
+{
+    std::string squareName(Square sq)
+    {
+        if (sq < 0 || sq >= SQUARE_COUNT)
+            return std::string();
+
+        for (const Corner &c : CORNERS)
+        {
+            if (c.square == sq)
+                return std::string{'w', c.digit};
+        }
+
+        const int row = Squares::rowOf(sq);
+        const int col = Squares::colOf(sq);
+        return std::string{static_cast<char>('a' + col - 1), static_cast<char>('0' + 10 - row)};
+    }
+
+    Square parseSquare(std::string_view text) noexcept
+    {
+        if (text.size() != 2)
+            return NO_SQUARE;
+
+        if (text[0] == 'w')
+        {
+            for (const Corner &c : CORNERS)
+            {
+                if (c.digit == text[1])
+                    return c.square;
+            }
+            return NO_SQUARE;
+        }
+
+        if (text[0] < 'a' || text[0] > 'j' || text[1] < '0' || text[1] > '9')
+            return NO_SQUARE;
+
+        return Squares::fromCell(10 - (text[1] - '0'), text[0] - 'a' + 1);
+    }
+
+    std::string moveToString(PackedMove move)
+    {
+        if (move.isNone())
+            return "0000";
+        return squareName(move.from()) + squareName(move.to());
+    }
+
+    PackedMove parseMove(const Board &board, std::string_view text)
+    {
+        if (text.size() != 4)
+            return PackedMove::none();
+
+        // Имя любой клетки — ровно два символа
+        const Square from = parseSquare(text.substr(0, 2));
+        const Square to   = parseSquare(text.substr(2, 2));
+        if (from == NO_SQUARE || to == NO_SQUARE)
+            return PackedMove::none();
+
+        // Флаг рокировки в записи не виден — берём ход из генератора
+        MoveList moves;
+        MoveGen::generateLegal(board, moves);
+        for (PackedMove m : moves)
+        {
+            if (m.from() == from && m.to() == to)
+                return m;
+        }
+        return PackedMove::none();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * Текстовая запись клеток и ходов Omega Chess (для протокола движка,
+ * журналов и файлов партий).
+ *
+ * Поле 10×10: вертикали a..j (col = 1..10), горизонтали 0..9 снизу
+ * вверх, со стороны белых (горизонталь = 10 - row). Углы волшебников:
+ *  - w1 = (11,0), w2 = (11,11) — за белыми, слева и справа
+ *  - w3 = (0,11), w4 = (0,0)   — за чёрными, справа и слева
+ *
+ * Ход — две клетки подряд, как в UCI: «e1g1», «w1b2». Рокировка
+ * записывается ходом короля.
+ */
+namespace Notation
+{
+    // Имя клетки («a0», «j9», «w1»); пустая строка для NO_SQUARE
+    std::string squareName(Square sq);
+
+    // Клетка по имени или NO_SQUARE, если имя не распознано
+    Square parseSquare(std::string_view text) noexcept;
+
+    // «откуда» + «куда»; для пустого хода — «0000»
+    std::string moveToString(PackedMove move);
+
+    // Найти среди легальных ходов позиции ход с такой записью;
+    // PackedMove::none(), если запись не распознана или ход нелегален
+    PackedMove parseMove(const Board &board, std::string_view text);
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Piece.hpp"
+#include "Square.hpp"
+
+/**
+ * Таблицы «фигура–клетка» (PSQT) для оценки позиции.
+ *
+ * Для каждого типа фигуры и каждой из 104 валидных клеток хранится
+ * пара значений — для миттельшпиля (mg) и эндшпиля (eg) — уже вместе
+ * с материалом. Таблицы заданы для белых; для чёрных клетка отражается
+ * по горизонтали доски (row → 11 - row), а знак меняется.
+ *
+ * Board суммирует значения всех фигур при каждой постановке и снятии
+ * фигуры, поэтому оценка листа — это чтение накопленной суммы и
+ * смешивание mg/eg по фазе партии (см. PHASE_WEIGHT).
+ */
+namespace Psqt
+{
+    struct Score
+    {
+        int mg = 0;
+        int eg = 0;
+
+        constexpr Score() = default;
+        constexpr Score(int m, int e) : mg(m), eg(e) {}
+
+        constexpr Score operator+(const Score &o) const noexcept { return Score(mg + o.mg, eg + o.eg); }
+        constexpr Score operator-(const Score &o) const noexcept { return Score(mg - o.mg, eg - o.eg); }
+        constexpr Score operator-() const noexcept { return Score(-mg, -eg); }
+
+        constexpr Score &operator+=(const Score &o) noexcept { mg += o.mg; eg += o.eg; return *this; }
+        constexpr Score &operator-=(const Score &o) noexcept { mg -= o.mg; eg -= o.eg; return *this; }
+
+        constexpr bool operator==(const Score &o) const noexcept { return mg == o.mg && eg == o.eg; }
+        constexpr bool operator!=(const Score &o) const noexcept { return !(*this == o); }
+    };
+
+    constexpr int KIND_COUNT = 9;   // None .. Wizard
+
+    // Вклад фигур в фазу: сумма по доске в начальной позиции — PHASE_MAX
+    // (чистый миттельшпиль), без фигур кроме пешек и королей — 0 (эндшпиль)
+    constexpr int PHASE_WEIGHT[KIND_COUNT] = {
+        0,  // None
+        0,  // King
+        4,  // Queen
+        2,  // Rook
+        1,  // Bishop
+        1,  // Knight
+        0,  // Pawn
+        2,  // Champion
+        1   // Wizard
+    };
+
+    constexpr int PHASE_MAX = 2 * (4 + 2 * 2 + 2 * 1 + 2 * 1 + 2 * 2 + 2 * 1);
+
+    namespace detail
+    {
+        // Материал (mg, eg); индекс — PieceKind
+        constexpr Score MATERIAL[KIND_COUNT] = {
+            {0, 0},       // None
+            {0, 0},       // King
+            {900, 950},   // Queen
+            {480, 530},   // Rook
+            {320, 340},   // Bishop
+            {290, 290},   // Knight
+            {90, 115},    // Pawn
+            {440, 470},   // Champion
+            {340, 350}    // Wizard
+        };
+
+        constexpr int absInt(int x) { return x < 0 ? -x : x; }
+        constexpr int maxInt(int a, int b) { return a > b ? a : b; }
+
+        // Близость к центру поля 10×10: 4 — четыре центральные клетки,
+        // 0 — край поля, -1 — угловые клетки волшебников
+        constexpr int centrality(int row, int col)
+        {
+            if (row == 0 || row == 11)
+                return -1;
+            const int dist = maxInt(absInt(2 * row - 11), absInt(2 * col - 11));   // 1, 3, …, 9
+            return (9 - dist) / 2;
+        }
+
+        // Позиционная часть для белой фигуры на (row, col)
+        constexpr Score positional(PieceKind kind, int row, int col)
+        {
+            const int centre = centrality(row, col);
+
+            switch (kind)
+            {
+            case PieceKind::Pawn:
+            {
+                // Белые пешки стартуют с 9-й строки и идут к 1-й
+                const int advance = 9 - row;
+                const int file    = (col == 5 || col == 6) ? 10 : (col == 4 || col == 7) ? 5 : 0;
+                return Score(5 * advance + file, 10 * advance);
+            }
+            case PieceKind::Knight:
+                return Score(8 * centre - 10, 6 * centre - 8);
+            case PieceKind::Bishop:
+                return Score(4 * centre, 3 * centre);
+            case PieceKind::Champion:
+                return Score(6 * centre, 5 * centre);
+            case PieceKind::Wizard:
+                return Score(5 * centre, 4 * centre);
+            case PieceKind::Rook:
+                // Вторая горизонталь соперника и центральные вертикали
+                return Score((row == 2 ? 15 : 0) + ((col == 5 || col == 6) ? 5 : 0), 0);
+            case PieceKind::Queen:
+                return Score(2 * centre, 4 * centre);
+            case PieceKind::King:
+            {
+                // В миттельшпиле — дома, в эндшпиле — в центре
+                const int shelter = (row == 10) ? 20 : (row == 9) ? 5 : maxInt(-40, -10 * (9 - row));
+                return Score(shelter, 10 * centre - 20);
+            }
+            default:
+                return Score();
+            }
+        }
+
+        using Table = std::array<std::array<Score, SQUARE_COUNT>, KIND_COUNT>;
+
+        constexpr Table makeTable()
+        {
+            Table table{};
+            for (int k = 1; k < KIND_COUNT; ++k)
+            {
+                const PieceKind kind = static_cast<PieceKind>(k);
+                for (int sq = 0; sq < SQUARE_COUNT; ++sq)
+                {
+                    const int row = Squares::rowOf(sq);
+                    const int col = Squares::colOf(sq);
+                    table[k][sq] = MATERIAL[k] + positional(kind, row, col);
+                }
+            }
+            return table;
+        }
+
+        constexpr std::array<std::int8_t, SQUARE_COUNT> makeMirror()
+        {
+            std::array<std::int8_t, SQUARE_COUNT> mirror{};
+            for (int sq = 0; sq < SQUARE_COUNT; ++sq)
+            {
+                mirror[sq] = static_cast<std::int8_t>(
+                    Squares::fromCell(Squares::ARRAY_ROWS - 1 - Squares::rowOf(sq), Squares::colOf(sq)));
+            }
+            return mirror;
+        }
+    }
+
+    /// Значения для белых: TABLE[kind][sq]
+    inline constexpr detail::Table TABLE = detail::makeTable();
+
+    /// Отражение клетки по горизонтали доски (для чёрных)
+    inline constexpr std::array<std::int8_t, SQUARE_COUNT> MIRROR = detail::makeMirror();
+
+    /// Вклад фигуры в оценку с точки зрения белых
+    constexpr Score value(PieceColor color, PieceKind kind, Square sq) noexcept
+    {
+        return color == PieceColor::White
+               ? TABLE[static_cast<int>(kind)][sq]
+               : -TABLE[static_cast<int>(kind)][MIRROR[sq]];
+    }
+
+    constexpr int phaseWeight(PieceKind kind) noexcept
+    {
+        return PHASE_WEIGHT[static_cast<int>(kind)];
+    }
+}
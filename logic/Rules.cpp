@@ -0,0 +1,312 @@
+#include "Rules.hpp"
+#include "Attacks.hpp"
+
+#include <cstdlib>
+
+static PieceColor opposite(PieceColor c)
+{
+    return (c == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+}
+
+// Проверка: фигура p с клетки (pr,pc) атакует ли клетку (tr,tc)?
+// Используем реальные шаблоны ходов Omega Chess (король, ферзь, ладья, слон, конь, пешка,
+// чемпион, волшебник). Для пешек учитываем только шаблон взятия.
+bool Rules::pieceAttacksSquare(const Board &board,
+                               const Piece &p,
+                               int pr, int pc,
+                               int tr, int tc)
+{
+    if (p.isEmpty())
+        return false;
+
+    const Square from = Squares::fromCell(pr, pc);
+    const Square to   = Squares::fromCell(tr, tc);
+    if (from == NO_SQUARE || to == NO_SQUARE)
+        return false;
+
+    // Прыгающие фигуры и взятие пешкой — таблицы атак, ладья/слон/ферзь —
+    // лучи с первой блокирующей фигурой (Attacks.hpp)
+    return Attacks::attacks(p.kind, p.color, from, board.occupied()).test(to);
+}
+
+// Проверка: может ли фигура p с клетки (fr,fc) пойти на (tr,tc)
+// с учётом типа хода (взятие / не взятие).
+// Здесь мы проверяем только "псевдолегальность":
+//  - шаблон хода по типу фигуры,
+//  - отсутствие фигур на пути для скользящих фигур (это уже делает pieceAttacksSquare).
+// Проверка шаха/само-шаха выполняется отдельно.
+bool Rules::pieceCanMove(const Board &board,
+                         const Piece &p,
+                         int fr, int fc,
+                         int tr, int tc,
+                         bool isCapture)
+{
+    if (p.isEmpty())
+        return false;
+
+    if (fr == tr && fc == tc)
+        return false;
+
+    const int dr = tr - fr;
+    const int dc = tc - fc;
+
+    // --- Пешка ---
+    if (p.kind == PieceKind::Pawn)
+    {
+        // Взятие пешкой: как в шахматах (на одну диагональ вперёд)
+        if (isCapture)
+        {
+            return pieceAttacksSquare(board, p, fr, fc, tr, tc);
+        }
+        else
+        {
+            // Тихий ход: только вперёд по вертикали
+            if (dc != 0)
+                return false;
+
+            const int WHITE_PAWN_START_ROW = 9;  // белые пешки стоят на 9-й горизонтали
+            const int BLACK_PAWN_START_ROW = 2;  // чёрные пешки стоят на 2-й горизонтали
+
+            if (p.color == PieceColor::White)
+            {
+                // Белые идут вверх (уменьшение row)
+                if (dr >= 0) // не вперёд
+                    return false;
+
+                const int steps = -dr; // 1,2,3
+
+                // После первого хода — только по 1
+                if (p.hasMoved)
+                {
+                    if (steps != 1)
+                        return false;
+                }
+                else
+                {
+                    // Первый ход: только с начальной горизонтали и на 1..3 клетки
+                    if (fr != WHITE_PAWN_START_ROW)
+                        return false;
+
+                    if (steps < 1 || steps > 3)
+                        return false;
+                }
+
+                // Проверяем, что все клетки по пути пусты
+                for (int k = 1; k <= -dr; ++k)
+                {
+                    const int r = fr - k;
+                    if (!board.isInsideArray(r, fc) || !board.isValidCell(r, fc))
+                        return false;
+                    if (!board.isEmpty(r, fc))
+                        return false;
+                }
+
+                return true;
+            }
+            else if (p.color == PieceColor::Black)
+            {
+                // Чёрные идут вниз (увеличение row)
+                if (dr <= 0)
+                    return false;
+
+                const int steps = dr; // 1,2,3
+
+                if (p.hasMoved)
+                {
+                    if (steps != 1)
+                        return false;
+                }
+                else
+                {
+                    if (fr != BLACK_PAWN_START_ROW)
+                        return false;
+
+                    if (steps < 1 || steps > 3)
+                        return false;
+                }
+
+                for (int k = 1; k <= dr; ++k)
+                {
+                    const int r = fr + k;
+                    if (!board.isInsideArray(r, fc) || !board.isValidCell(r, fc))
+                        return false;
+                    if (!board.isEmpty(r, fc))
+                        return false;
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+    }
+
+    // --- Остальные фигуры (король — без рокировки): ход совпадает с атакой ---
+    return pieceAttacksSquare(board, p, fr, fc, tr, tc);
+}
+
+// ---------------------------------------------------------------------
+// Логика шаха
+// ---------------------------------------------------------------------
+
+bool Rules::isKingInCheck(const Board &board, PieceColor side)
+{
+    const Square kingSq = board.kingSquare(side);
+    if (kingSq == NO_SQUARE)
+    {
+        // Теоретически этого быть не должно (мы запрещаем взятие короля),
+        // но на всякий случай считаем, что король "под бесконечным шахом".
+        return true;
+    }
+
+    return (attackersTo(board, kingSq) & board.pieces(opposite(side))).any();
+}
+
+Bitboard Rules::attackersTo(const Board &board, Square sq, Bitboard occupied)
+{
+    // Прыгающие фигуры: шаблоны симметричны, поэтому атакующие стоят
+    // на клетках таблицы атак самой клетки sq. Белые пешки бьют sq с клеток,
+    // которые бьёт с sq чёрная пешка, и наоборот.
+    Bitboard attackers =
+        (Attacks::KNIGHT[sq]     & board.pieces(PieceKind::Knight))   |
+        (Attacks::KING[sq]       & board.pieces(PieceKind::King))     |
+        (Attacks::CHAMPION[sq]   & board.pieces(PieceKind::Champion)) |
+        (Attacks::WIZARD[sq]     & board.pieces(PieceKind::Wizard))   |
+        (Attacks::BLACK_PAWN[sq] & board.pieces(PieceColor::White, PieceKind::Pawn)) |
+        (Attacks::WHITE_PAWN[sq] & board.pieces(PieceColor::Black, PieceKind::Pawn));
+
+    // Скользящие фигуры: лучи от sq до первой занятой клетки
+    const Bitboard queens     = board.pieces(PieceKind::Queen);
+    const Bitboard rookLike   = board.pieces(PieceKind::Rook)   | queens;
+    const Bitboard bishopLike = board.pieces(PieceKind::Bishop) | queens;
+
+    attackers |= (Attacks::rook(sq, occupied)   & rookLike) |
+                 (Attacks::bishop(sq, occupied) & bishopLike);
+
+    return attackers & occupied;
+}
+
+Bitboard Rules::attackersTo(const Board &board, Square sq)
+{
+    return attackersTo(board, sq, board.occupied());
+}
+
+bool Rules::isSquareAttacked(const Board &board, int row, int col, PieceColor bySide)
+{
+    const Square sq = Squares::fromCell(row, col);
+    if (sq == NO_SQUARE)
+        return false;
+
+    return (attackersTo(board, sq) & board.pieces(bySide)).any();
+}
+
+// ---------------------------------------------------------------------
+// Проверка и применение хода
+// ---------------------------------------------------------------------
+
+bool Rules::decodeMove(const Board &board, const Move &move, PackedMove &out)
+{
+    const int fromRow = move.from.row;
+    const int fromCol = move.from.col;
+    const int toRow   = move.to.row;
+    const int toCol   = move.to.col;
+
+    if (!board.isInsideArray(fromRow, fromCol) ||
+        !board.isInsideArray(toRow, toCol))
+    {
+        return false;
+    }
+
+    if (!board.isValidCell(fromRow, fromCol) ||
+        !board.isValidCell(toRow, toCol))
+    {
+        return false;
+    }
+
+    const Piece &fromPiece = board.pieceAt(fromRow, fromCol);
+    if (fromPiece.isEmpty())
+    {
+        return false;
+    }
+
+    // Ходим только своей фигурой
+    if (fromPiece.color != board.sideToMove())
+    {
+        return false;
+    }
+
+    const Piece &toPiece = board.pieceAt(toRow, toCol);
+
+    // Нельзя бить свою фигуру
+    if (!toPiece.isEmpty() && toPiece.color == fromPiece.color)
+    {
+        return false;
+    }
+
+    const bool isCapture = !toPiece.isEmpty();
+
+    // Нельзя "снимать" короля противника
+    if (isCapture && toPiece.kind == PieceKind::King)
+    {
+        return false;
+    }
+
+    const Square from = Squares::fromCell(fromRow, fromCol);
+    const Square to   = Squares::fromCell(toRow, toCol);
+
+    // --- Специальный случай: рокировка ---
+    if (fromPiece.kind == PieceKind::King &&
+        !fromPiece.hasMoved &&
+        fromRow == toRow &&
+        !isCapture &&
+        std::abs(toCol - fromCol) == 2)
+    {
+        const int dir = (toCol > fromCol) ? 1 : -1;      // +1: рокировка на "королевский" фланг, -1: на "ферзевый"
+        const int midCol = fromCol + dir;
+
+        // Ищем ладью в нужную сторону: первая фигура на линии должна быть ладьёй того же цвета, ещё не ходившей
+        int rookCol = -1;
+        int c = fromCol + dir;
+        while (board.isInsideArray(fromRow, c) && board.isValidCell(fromRow, c))
+        {
+            if (!board.isEmpty(fromRow, c))
+            {
+                const Piece &rp = board.pieceAt(fromRow, c);
+                if (rp.kind == PieceKind::Rook &&
+                    rp.color == fromPiece.color &&
+                    !rp.hasMoved)
+                {
+                    rookCol = c;
+                }
+                break; // встретили первую фигуру на пути — дальше искать нельзя
+            }
+            c += dir;
+        }
+
+        if (rookCol == -1)
+        {
+            return false; // ладья не найдена или между королём и ладьёй стоит другая фигура
+        }
+
+        // Проверка атакованных полей: исходное, промежуточное и конечное поле короля не должны быть под боем
+        const PieceColor enemy = opposite(fromPiece.color);
+        if (isSquareAttacked(board, fromRow, fromCol, enemy) ||
+            isSquareAttacked(board, fromRow, midCol, enemy)  ||
+            isSquareAttacked(board, fromRow, toCol,  enemy))
+        {
+            return false;
+        }
+
+        out = PackedMove(from, to, PackedMove::Castling);
+        return true;
+    }
+
+    // --- Обычный ход (не рокировка) ---
+    if (!pieceCanMove(board, fromPiece, fromRow, fromCol, toRow, toCol, isCapture))
+    {
+        return false;
+    }
+
+    out = PackedMove(from, to);
+    return true;
+}
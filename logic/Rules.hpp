@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * Правила ходов Omega Chess без привязки к Qt.
+ *
+ * Используются GameController (проверка хода пользователя)
+ * и генератором ходов MoveGen, поэтому обе стороны всегда
+ * согласованы в том, какие ходы допустимы.
+ */
+namespace Rules
+{
+    // Атакует ли фигура p с клетки (pr,pc) клетку (tr,tc)?
+    // Для пешек учитывается только шаблон взятия.
+    bool pieceAttacksSquare(const Board &board,
+                            const Piece &p,
+                            int pr, int pc,
+                            int tr, int tc);
+
+    // Может ли фигура p с клетки (fr,fc) пойти на (tr,tc) — только
+    // «псевдолегальность» (шаблон хода и препятствия), без шаха и рокировки.
+    bool pieceCanMove(const Board &board,
+                      const Piece &p,
+                      int fr, int fc,
+                      int tr, int tc,
+                      bool isCapture);
+
+    /**
+     * Все фигуры (обоих цветов), атакующие клетку sq, при занятости occupied.
+     * Поиск идёт от самой клетки: таблицы прыгающих фигур плюс по одному
+     * лучу в каждом из 8 направлений до первой занятой клетки. Занятость
+     * передаётся отдельно, чтобы можно было «снять» фигуры (для SEE и т.п.).
+     */
+    Bitboard attackersTo(const Board &board, Square sq, Bitboard occupied);
+    Bitboard attackersTo(const Board &board, Square sq);
+
+    // Клетка (row,col) под атакой фигур цвета bySide?
+    bool isSquareAttacked(const Board &board, int row, int col, PieceColor bySide);
+
+    // Король цвета side под ударом? Отсутствие короля считается шахом.
+    bool isKingInCheck(const Board &board, PieceColor side);
+
+    /**
+     * Проверить псевдолегальность хода стороны board.sideToMove()
+     * (включая рокировку) и упаковать его. Доска не изменяется.
+     * Само-шах здесь не проверяется.
+     */
+    bool decodeMove(const Board &board, const Move &move, PackedMove &out);
+}
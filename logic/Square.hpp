@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Компактная нумерация валидных клеток Omega-доски.
+ *
+ * Массив доски — 12×12, но валидных клеток только 104
+ * (поле 10×10 + 4 угла волшебников). Они нумеруются построчно
+ * сверху вниз и слева направо:
+ *  - (0,0)  → 0,   (0,11)  → 1
+ *  - (row,col) основного поля → 2 + (row-1)*10 + (col-1)   (2..101)
+ *  - (11,0) → 102, (11,11) → 103
+ *
+ * Порядок монотонен по (row, col): вдоль любого луча, идущего вниз
+ * или вправо, индексы растут, а вверх или влево — убывают.
+ */
+using Square = int;
+
+constexpr int    SQUARE_COUNT = 104;
+constexpr Square NO_SQUARE    = -1;
+
+namespace Squares
+{
+    constexpr int ARRAY_ROWS = 12;
+    constexpr int ARRAY_COLS = 12;
+    constexpr int CELL_COUNT = ARRAY_ROWS * ARRAY_COLS;
+
+    namespace detail
+    {
+        constexpr bool isValidCell(int row, int col)
+        {
+            if (row < 0 || row >= ARRAY_ROWS || col < 0 || col >= ARRAY_COLS)
+                return false;
+
+            if (row >= 1 && row <= 10 && col >= 1 && col <= 10)
+                return true;
+
+            return (row == 0 || row == ARRAY_ROWS - 1) &&
+                   (col == 0 || col == ARRAY_COLS - 1);
+        }
+
+        constexpr std::array<std::int8_t, CELL_COUNT> makeCellToSquare()
+        {
+            std::array<std::int8_t, CELL_COUNT> table{};
+            int next = 0;
+            for (int r = 0; r < ARRAY_ROWS; ++r)
+            {
+                for (int c = 0; c < ARRAY_COLS; ++c)
+                {
+                    table[r * ARRAY_COLS + c] = isValidCell(r, c)
+                                                ? static_cast<std::int8_t>(next++)
+                                                : static_cast<std::int8_t>(NO_SQUARE);
+                }
+            }
+            return table;
+        }
+
+        constexpr std::array<std::uint8_t, SQUARE_COUNT> makeSquareToCell()
+        {
+            std::array<std::uint8_t, SQUARE_COUNT> table{};
+            int next = 0;
+            for (int cell = 0; cell < CELL_COUNT; ++cell)
+            {
+                if (isValidCell(cell / ARRAY_COLS, cell % ARRAY_COLS))
+                    table[next++] = static_cast<std::uint8_t>(cell);
+            }
+            return table;
+        }
+    }
+
+    /// Индекс клетки массива (row*12 + col) → Square или NO_SQUARE
+    inline constexpr std::array<std::int8_t, CELL_COUNT> CELL_TO_SQUARE = detail::makeCellToSquare();
+
+    /// Square → индекс клетки массива (row*12 + col)
+    inline constexpr std::array<std::uint8_t, SQUARE_COUNT> SQUARE_TO_CELL = detail::makeSquareToCell();
+
+    constexpr bool isInsideArray(int row, int col) noexcept
+    {
+        return row >= 0 && row < ARRAY_ROWS &&
+               col >= 0 && col < ARRAY_COLS;
+    }
+
+    /// Square по координатам массива; NO_SQUARE для невалидных клеток и выхода за массив
+    constexpr Square fromCell(int row, int col) noexcept
+    {
+        return isInsideArray(row, col)
+               ? CELL_TO_SQUARE[row * ARRAY_COLS + col]
+               : NO_SQUARE;
+    }
+
+    constexpr int rowOf(Square sq) noexcept { return SQUARE_TO_CELL[sq] / ARRAY_COLS; }
+    constexpr int colOf(Square sq) noexcept { return SQUARE_TO_CELL[sq] % ARRAY_COLS; }
+}
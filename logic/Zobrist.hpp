@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Piece.hpp"
+#include "Square.hpp"
+
+/**
+ * Ключи Zobrist для позиций Omega Chess.
+ *
+ * Ключ позиции — XOR ключей:
+ *  - каждой фигуры (цвет, тип, клетка) на 104 валидных клетках;
+ *  - права на рокировку (4 бита → 16 ключей, для «нет прав» — 0);
+ *  - стороны хода (если ходят чёрные).
+ *
+ * Таблицы генерируются на этапе компиляции (splitmix64 с фиксированным
+ * зерном), поэтому ключи одинаковы между запусками и сборками —
+ * на них можно опираться в файлах на диске.
+ */
+namespace Zobrist
+{
+    constexpr int COLOR_COUNT    = 2;   // White, Black
+    constexpr int KIND_COUNT     = 8;   // King .. Wizard
+    constexpr int CASTLING_COUNT = 16;
+
+    namespace detail
+    {
+        constexpr std::uint64_t splitmix64(std::uint64_t &state)
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        struct Keys
+        {
+            std::uint64_t piece[COLOR_COUNT][KIND_COUNT][SQUARE_COUNT] = {};
+            std::uint64_t castling[CASTLING_COUNT] = {};
+            std::uint64_t side = 0;
+        };
+
+        constexpr Keys makeKeys()
+        {
+            Keys keys{};
+            std::uint64_t state = 0x0DE6AC4E55ull;
+
+            for (int c = 0; c < COLOR_COUNT; ++c)
+                for (int k = 0; k < KIND_COUNT; ++k)
+                    for (int sq = 0; sq < SQUARE_COUNT; ++sq)
+                        keys.piece[c][k][sq] = splitmix64(state);
+
+            // Без прав на рокировку ключ нулевой: пустая доска с ходом белых → 0
+            for (int r = 1; r < CASTLING_COUNT; ++r)
+                keys.castling[r] = splitmix64(state);
+
+            keys.side = splitmix64(state);
+            return keys;
+        }
+    }
+
+    inline constexpr detail::Keys KEYS = detail::makeKeys();
+
+    // Фигура должна быть непустой
+    constexpr std::uint64_t piece(PieceColor color, PieceKind kind, Square sq) noexcept
+    {
+        return KEYS.piece[static_cast<int>(color) - 1][static_cast<int>(kind) - 1][sq];
+    }
+
+    constexpr std::uint64_t castling(int rights) noexcept { return KEYS.castling[rights]; }
+    constexpr std::uint64_t side() noexcept { return KEYS.side; }
+}
@@ -0,0 +1,58 @@
+#include "Evaluate.hpp"
+
+namespace
+{
+    // Индекс — PieceKind: None, King, Queen, Rook, Bishop, Knight, Pawn, Champion, Wizard
+    constexpr int PIECE_VALUES[] = {0, 0, 900, 500, 325, 300, 100, 450, 350};
+
+    // Проходная со свободной клеткой впереди: eg-бонус за горизонталь продвижения
+    constexpr int FREE_PASSER_EG = 4;
+
+    // Зависит от всех фигур, поэтому не кэшируется вместе со структурой
+    int freePassers(const Board &board, PieceColor color, Bitboard passed) noexcept
+    {
+        const int dir = (color == PieceColor::White) ? -1 : 1;
+        int bonus = 0;
+        while (passed.any())
+        {
+            const Square sq   = passed.popLsb();
+            const Square stop = Squares::fromCell(Squares::rowOf(sq) + dir, Squares::colOf(sq));
+            if (stop != NO_SQUARE && !board.occupied().test(stop))
+                bonus += FREE_PASSER_EG * Pawns::advancement(color, sq);
+        }
+        return bonus;
+    }
+
+    int evaluateWith(const Board &board, const PawnEntry &pawns) noexcept
+    {
+        Psqt::Score score = board.psqt() + pawns.score;
+        score.eg += freePassers(board, PieceColor::White, pawns.passedPawns(PieceColor::White))
+                  - freePassers(board, PieceColor::Black, pawns.passedPawns(PieceColor::Black));
+
+        const int white = Eval::taper(score, board.phase());
+        return board.sideToMove() == PieceColor::White ? white : -white;
+    }
+}
+
+int Eval::pieceValue(PieceKind kind) noexcept
+{
+    return PIECE_VALUES[static_cast<int>(kind)];
+}
+
+int Eval::taper(const Psqt::Score &score, int phase) noexcept
+{
+    if (phase > Psqt::PHASE_MAX)
+        phase = Psqt::PHASE_MAX;
+
+    return (score.mg * phase + score.eg * (Psqt::PHASE_MAX - phase)) / Psqt::PHASE_MAX;
+}
+
+int Eval::evaluate(const Board &board) noexcept
+{
+    return evaluateWith(board, Pawns::analyze(board));
+}
+
+int Eval::evaluate(const Board &board, PawnTable &pawns) noexcept
+{
+    return evaluateWith(board, pawns.probe(board));
+}
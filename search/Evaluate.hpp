@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Board.hpp"
+#include "PawnTable.hpp"
+#include "Piece.hpp"
+
+/**
+ * Статическая оценка позиции для поиска.
+ *
+ * Материал и таблицы «фигура–клетка» (Psqt.hpp) для миттельшпиля и
+ * эндшпиля, смешанные по фазе партии. Обе суммы и фазу ведёт сама
+ * Board при make/unmake, так что оценка листа — несколько сложений
+ * и одно деление. К ним добавляется пешечная структура (PawnTable.hpp)
+ * и бонус проходным со свободной клеткой впереди. Оценка даётся с точки
+ * зрения стороны, которой принадлежит ход: положительная — её перевес.
+ */
+namespace Eval
+{
+    // Стоимость фигуры для разменов (SEE, MVV-LVA); у короля — 0 (его нельзя взять)
+    int pieceValue(PieceKind kind) noexcept;
+
+    // Пешечная структура разбирается с нуля
+    int evaluate(const Board &board) noexcept;
+
+    // То же, пешечная структура — из кэша pawns (поиск)
+    int evaluate(const Board &board, PawnTable &pawns) noexcept;
+
+    // Смешать mg/eg по фазе (с точки зрения белых)
+    int taper(const Psqt::Score &score, int phase) noexcept;
+}
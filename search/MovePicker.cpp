@@ -0,0 +1,203 @@
+#include "MovePicker.hpp"
+#include "Evaluate.hpp"
+#include "MoveGen.hpp"
+#include "Rules.hpp"
+#include "See.hpp"
+
+#include <cstdlib>
+
+// ---------------------------------------------------------------------
+// История
+// ---------------------------------------------------------------------
+
+void HistoryTable::clear() noexcept
+{
+    for (auto &byFrom : m_table)
+        for (auto &byTo : byFrom)
+            for (int &v : byTo)
+                v = 0;
+}
+
+void HistoryTable::update(PieceColor color, PackedMove move, int bonus) noexcept
+{
+    if (bonus > MAX_SCORE)  bonus = MAX_SCORE;
+    if (bonus < -MAX_SCORE) bonus = -MAX_SCORE;
+
+    // Чем ближе значение к границе, тем слабее сдвиг: значения не
+    // выходят за ±MAX_SCORE, а старые заслуги постепенно забываются
+    int &v = m_table[colorIndex(color)][move.from()][move.to()];
+    v += bonus - v * std::abs(bonus) / MAX_SCORE;
+}
+
+// ---------------------------------------------------------------------
+// Выдача ходов
+// ---------------------------------------------------------------------
+
+MovePicker::MovePicker(const Board &board,
+                       PackedMove hashMove,
+                       const PackedMove (&killers)[2],
+                       const HistoryTable &history)
+    : m_board(board)
+    , m_history(&history)
+    , m_stage(StageHash)
+    , m_capturesOnly(false)
+    , m_hashMove(hashMove)
+    , m_killers{killers[0], killers[1]}
+{
+}
+
+MovePicker::MovePicker(const Board &board)
+    : m_board(board)
+    , m_stage(StageGenerate)
+    , m_capturesOnly(true)
+{
+}
+
+PackedMove MovePicker::next()
+{
+    for (;;)
+    {
+        switch (m_stage)
+        {
+        case StageHash:
+            m_stage = StageGenerate;
+            if (!m_hashMove.isNone() && isPseudoLegal(m_hashMove))
+                return m_hashMove;
+            m_hashMove = PackedMove::none();
+            break;
+
+        case StageGenerate:
+            generate();
+            m_index = 0;
+            m_stage = StageCaptures;
+            break;
+
+        case StageCaptures:
+            // Выбор лучшего из оставшихся: после отсечения сортировать дальше незачем
+            while (m_index < m_captures.size())
+            {
+                int best = m_index;
+                for (int i = m_index + 1; i < m_captures.size(); ++i)
+                {
+                    if (m_scores[i] > m_scores[best])
+                        best = i;
+                }
+
+                const PackedMove m = m_captures[best];
+                m_captures[best] = m_captures[m_index];
+                m_scores[best]   = m_scores[m_index];
+                ++m_index;
+
+                if (m == m_hashMove)
+                    continue;
+
+                // Проигрывающие взятия — в конец (в поиске взятий — не нужны)
+                if (!See::atLeast(m_board, m, 0))
+                {
+                    if (!m_capturesOnly)
+                        m_badCaptures.push(m);
+                    continue;
+                }
+                return m;
+            }
+            m_stage = m_capturesOnly ? StageDone : StageKiller1;
+            break;
+
+        case StageKiller1:
+        case StageKiller2:
+        {
+            const PackedMove killer = m_killers[m_stage == StageKiller1 ? 0 : 1];
+            m_stage = static_cast<Stage>(m_stage + 1);
+
+            if (!killer.isNone() && killer != m_hashMove &&
+                isQuiet(killer) && isPseudoLegal(killer))
+            {
+                return killer;
+            }
+            break;
+        }
+
+        case StageQuietsSort:
+            // Сортировка вставками по истории
+            for (int i = 0; i < m_quiets.size(); ++i)
+                m_scores[i] = m_history->get(m_board.sideToMove(), m_quiets[i]);
+
+            for (int i = 1; i < m_quiets.size(); ++i)
+            {
+                const PackedMove m = m_quiets[i];
+                const int        s = m_scores[i];
+                int j = i - 1;
+                while (j >= 0 && m_scores[j] < s)
+                {
+                    m_quiets[j + 1] = m_quiets[j];
+                    m_scores[j + 1] = m_scores[j];
+                    --j;
+                }
+                m_quiets[j + 1] = m;
+                m_scores[j + 1] = s;
+            }
+            m_index = 0;
+            m_stage = StageQuiets;
+            break;
+
+        case StageQuiets:
+            while (m_index < m_quiets.size())
+            {
+                const PackedMove m = m_quiets[m_index++];
+                if (!alreadyTried(m))
+                    return m;
+            }
+            m_index = 0;
+            m_stage = StageBadCaptures;
+            break;
+
+        case StageBadCaptures:
+            if (m_index < m_badCaptures.size())
+                return m_badCaptures[m_index++];
+            m_stage = StageDone;
+            break;
+
+        case StageDone:
+            return PackedMove::none();
+        }
+    }
+}
+
+void MovePicker::generate()
+{
+    MoveList all;
+    MoveGen::generatePseudoLegal(m_board, all);
+
+    for (PackedMove m : all)
+    {
+        if (isQuiet(m))
+        {
+            if (!m_capturesOnly)
+                m_quiets.push(m);
+            continue;
+        }
+
+        // MVV-LVA: сначала самая ценная жертва, при равной — самый дешёвый нападающий
+        const int victim   = Eval::pieceValue(m_board.pieceAt(m.to()).kind);
+        const int attacker = Eval::pieceValue(m_board.pieceAt(m.from()).kind);
+        m_scores[m_captures.size()] = victim * 8 - attacker;
+        m_captures.push(m);
+    }
+}
+
+bool MovePicker::isPseudoLegal(PackedMove move) const
+{
+    // Ход из таблицы или киллер мог прийти из другой позиции
+    PackedMove decoded;
+    return Rules::decodeMove(m_board, move.toMove(), decoded) && decoded == move;
+}
+
+bool MovePicker::isQuiet(PackedMove move) const noexcept
+{
+    return move.isCastling() || m_board.pieceAt(move.to()).isEmpty();
+}
+
+bool MovePicker::alreadyTried(PackedMove move) const noexcept
+{
+    return move == m_hashMove || move == m_killers[0] || move == m_killers[1];
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * История «бабочкой»: оценка тихого хода по паре клеток (from, to)
+ * 104 валидных клеток, отдельно для каждого цвета. Растёт, когда ход
+ * вызывает отсечение, и убывает у тихих ходов, перебранных до него.
+ */
+class HistoryTable
+{
+public:
+    static constexpr int MAX_SCORE = 16384;
+
+    HistoryTable() { clear(); }
+
+    void clear() noexcept;
+
+    int get(PieceColor color, PackedMove move) const noexcept
+    {
+        return m_table[colorIndex(color)][move.from()][move.to()];
+    }
+
+    // Добавить bonus (может быть отрицательным); значения насыщаются у ±MAX_SCORE
+    void update(PieceColor color, PackedMove move, int bonus) noexcept;
+
+private:
+    static int colorIndex(PieceColor color) noexcept
+    {
+        return color == PieceColor::White ? 0 : 1;
+    }
+
+    int m_table[2][SQUARE_COUNT][SQUARE_COUNT];
+};
+
+/**
+ * Поэтапная выдача ходов для поиска.
+ *
+ * Основной поиск:
+ *  1. ход из таблицы транспозиций (проверяется, без генерации);
+ *  2. взятия по MVV-LVA (ценность фигур Omega, см. Eval::pieceValue),
+ *     кроме проигрывающих материал по SEE;
+ *  3. два хода-киллера этого ply (тихие ходы, давшие отсечение у соседей);
+ *  4. остальные тихие ходы по истории;
+ *  5. проигрывающие взятия.
+ * Поиск взятий: только этап 2, проигрывающие взятия отбрасываются.
+ *
+ * Выдаются псевдолегальные ходы; само-шах проверяет вызывающая сторона.
+ * Если отсечение случилось рано, до генерации и сортировки тихих ходов
+ * дело не доходит.
+ */
+class MovePicker
+{
+public:
+    // Основной поиск
+    MovePicker(const Board &board,
+               PackedMove hashMove,
+               const PackedMove (&killers)[2],
+               const HistoryTable &history);
+
+    // Поиск взятий
+    explicit MovePicker(const Board &board);
+
+    // Следующий ход или PackedMove::none(), если ходов больше нет
+    PackedMove next();
+
+private:
+    enum Stage
+    {
+        StageHash,
+        StageGenerate,
+        StageCaptures,
+        StageKiller1,
+        StageKiller2,
+        StageQuietsSort,
+        StageQuiets,
+        StageBadCaptures,
+        StageDone
+    };
+
+    bool isPseudoLegal(PackedMove move) const;
+    bool isQuiet(PackedMove move) const noexcept;
+    bool alreadyTried(PackedMove move) const noexcept;
+    void generate();
+
+    const Board        &m_board;
+    const HistoryTable *m_history = nullptr;
+
+    Stage      m_stage;
+    bool       m_capturesOnly;
+    PackedMove m_hashMove;
+    PackedMove m_killers[2];
+
+    MoveList m_captures;
+    MoveList m_badCaptures;
+    MoveList m_quiets;
+    int      m_scores[MoveList::CAPACITY];
+    int      m_index = 0;
+};
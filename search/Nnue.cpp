@@ -0,0 +1,283 @@
+#include "Nnue.hpp"
+#include "Psqt.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace
+{
+    constexpr char MAGIC[8] = {'O', 'M', 'E', 'G', 'A', 'N', 'N', '\0'};
+
+    // Масштабы целочисленной арифметики: сдвиг после первого плотного
+    // слоя и делитель выхода сети до сантипешек
+    constexpr int L1_SHIFT     = 6;
+    constexpr int OUTPUT_SCALE = 16;
+
+    constexpr std::size_t FT_BIAS_BYTES    = Nnue::HIDDEN * sizeof(std::int16_t);
+    constexpr std::size_t FT_WEIGHTS_BYTES = std::size_t{Nnue::FEATURES} * Nnue::HIDDEN * sizeof(std::int16_t);
+    constexpr std::size_t L1_BIAS_BYTES    = Nnue::L1_OUT * sizeof(std::int32_t);
+    constexpr std::size_t L1_WEIGHTS_BYTES = Nnue::L1_OUT * 2 * Nnue::HIDDEN;
+    constexpr std::size_t L2_BIAS_BYTES    = sizeof(std::int32_t);
+    constexpr std::size_t L2_WEIGHTS_BYTES = Nnue::L1_OUT;
+
+    std::uint32_t readU32(const std::uint8_t *p) noexcept
+    {
+        return  static_cast<std::uint32_t>(p[0])
+             | (static_cast<std::uint32_t>(p[1]) << 8)
+             | (static_cast<std::uint32_t>(p[2]) << 16)
+             | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    void writeU32(std::uint8_t *p, std::uint32_t v) noexcept
+    {
+        p[0] = static_cast<std::uint8_t>(v);
+        p[1] = static_cast<std::uint8_t>(v >> 8);
+        p[2] = static_cast<std::uint8_t>(v >> 16);
+        p[3] = static_cast<std::uint8_t>(v >> 24);
+    }
+
+    bool isLittleEndian() noexcept
+    {
+        const std::uint16_t probe = 1;
+        std::uint8_t first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    constexpr PieceColor PERSPECTIVES[2] = {PieceColor::White, PieceColor::Black};
+}
+
+// ---------------------------------------------------------------------
+// Признаки
+// ---------------------------------------------------------------------
+
+int Nnue::featureIndex(PieceColor perspective, PieceColor color, PieceKind kind, Square sq) noexcept
+{
+    const int relColor = (color == perspective) ? 0 : 1;
+    const int relSq    = (perspective == PieceColor::White) ? sq : Psqt::MIRROR[sq];
+    return (relColor * 8 + (static_cast<int>(kind) - 1)) * SQUARE_COUNT + relSq;
+}
+
+// ---------------------------------------------------------------------
+// Веса
+// ---------------------------------------------------------------------
+
+std::size_t Nnue::Network::fileSize() noexcept
+{
+    return HEADER_SIZE + FT_BIAS_BYTES + FT_WEIGHTS_BYTES + L1_BIAS_BYTES +
+           L1_WEIGHTS_BYTES + L2_BIAS_BYTES + L2_WEIGHTS_BYTES;
+}
+
+bool Nnue::Network::bind(const std::uint8_t *data, std::size_t size)
+{
+    // Веса лежат в файле как есть — нужен little-endian процессор
+    if (!isLittleEndian() || size != fileSize())
+        return false;
+
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        readU32(data + 8)  != FILE_VERSION ||
+        readU32(data + 12) != static_cast<std::uint32_t>(FEATURES) ||
+        readU32(data + 16) != static_cast<std::uint32_t>(HIDDEN) ||
+        readU32(data + 20) != static_cast<std::uint32_t>(L1_OUT))
+    {
+        return false;
+    }
+
+    const std::uint8_t *p = data + HEADER_SIZE;
+    m_ftBias    = reinterpret_cast<const std::int16_t *>(p); p += FT_BIAS_BYTES;
+    m_ftWeights = reinterpret_cast<const std::int16_t *>(p); p += FT_WEIGHTS_BYTES;
+    m_l1Bias    = reinterpret_cast<const std::int32_t *>(p); p += L1_BIAS_BYTES;
+    m_l1Weights = reinterpret_cast<const std::int8_t *>(p);  p += L1_WEIGHTS_BYTES;
+    m_l2Bias    = reinterpret_cast<const std::int32_t *>(p); p += L2_BIAS_BYTES;
+    m_l2Weights = reinterpret_cast<const std::int8_t *>(p);
+    return true;
+}
+
+bool Nnue::Network::load(const std::string &path)
+{
+    Network candidate;
+    if (!candidate.m_file.open(path) ||
+        !candidate.bind(candidate.m_file.data(), candidate.m_file.size()))
+    {
+        return false;
+    }
+
+    // Перемещение не трогает страницы отображения — указатели остаются верны
+    *this = std::move(candidate);
+    return true;
+}
+
+bool Nnue::Network::save(const std::string &path) const
+{
+    if (!isLoaded())
+        return false;
+
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    std::uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    writeU32(header + 8,  FILE_VERSION);
+    writeU32(header + 12, static_cast<std::uint32_t>(FEATURES));
+    writeU32(header + 16, static_cast<std::uint32_t>(HIDDEN));
+    writeU32(header + 20, static_cast<std::uint32_t>(L1_OUT));
+
+    bool ok = std::fwrite(header, 1, HEADER_SIZE, f) == HEADER_SIZE;
+    ok = ok && std::fwrite(m_ftBias,    1, FT_BIAS_BYTES,    f) == FT_BIAS_BYTES;
+    ok = ok && std::fwrite(m_ftWeights, 1, FT_WEIGHTS_BYTES, f) == FT_WEIGHTS_BYTES;
+    ok = ok && std::fwrite(m_l1Bias,    1, L1_BIAS_BYTES,    f) == L1_BIAS_BYTES;
+    ok = ok && std::fwrite(m_l1Weights, 1, L1_WEIGHTS_BYTES, f) == L1_WEIGHTS_BYTES;
+    ok = ok && std::fwrite(m_l2Bias,    1, L2_BIAS_BYTES,    f) == L2_BIAS_BYTES;
+    ok = ok && std::fwrite(m_l2Weights, 1, L2_WEIGHTS_BYTES, f) == L2_WEIGHTS_BYTES;
+
+    return std::fclose(f) == 0 && ok;
+}
+
+Nnue::Network Nnue::Network::random(std::uint32_t seed)
+{
+    Network net;
+    net.m_buffer.assign(fileSize(), 0);
+
+    std::uint8_t *data = net.m_buffer.data();
+    std::memcpy(data, MAGIC, sizeof(MAGIC));
+    writeU32(data + 8,  FILE_VERSION);
+    writeU32(data + 12, static_cast<std::uint32_t>(FEATURES));
+    writeU32(data + 16, static_cast<std::uint32_t>(HIDDEN));
+    writeU32(data + 20, static_cast<std::uint32_t>(L1_OUT));
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> ftDist(-24, 24);
+    std::uniform_int_distribution<int> denseDist(-64, 64);
+    std::uniform_int_distribution<int> biasDist(-256, 256);
+
+    // Секции заполняются через memcpy: буфер не обязан быть выровнен под int16/int32
+    std::uint8_t *p = data + HEADER_SIZE;
+    for (std::size_t i = 0; i < FT_BIAS_BYTES / sizeof(std::int16_t); ++i, p += sizeof(std::int16_t))
+    {
+        const std::int16_t v = static_cast<std::int16_t>(ftDist(rng) + 32);
+        std::memcpy(p, &v, sizeof(v));
+    }
+    for (std::size_t i = 0; i < FT_WEIGHTS_BYTES / sizeof(std::int16_t); ++i, p += sizeof(std::int16_t))
+    {
+        const std::int16_t v = static_cast<std::int16_t>(ftDist(rng));
+        std::memcpy(p, &v, sizeof(v));
+    }
+    for (std::size_t i = 0; i < L1_BIAS_BYTES / sizeof(std::int32_t); ++i, p += sizeof(std::int32_t))
+    {
+        const std::int32_t v = biasDist(rng);
+        std::memcpy(p, &v, sizeof(v));
+    }
+    for (std::size_t i = 0; i < L1_WEIGHTS_BYTES; ++i, ++p)
+        *p = static_cast<std::uint8_t>(static_cast<std::int8_t>(denseDist(rng)));
+    {
+        const std::int32_t v = biasDist(rng);
+        std::memcpy(p, &v, sizeof(v));
+        p += sizeof(v);
+    }
+    for (std::size_t i = 0; i < L2_WEIGHTS_BYTES; ++i, ++p)
+        *p = static_cast<std::uint8_t>(static_cast<std::int8_t>(denseDist(rng)));
+
+    net.bind(net.m_buffer.data(), net.m_buffer.size());
+    return net;
+}
+
+// ---------------------------------------------------------------------
+// Оценщик
+// ---------------------------------------------------------------------
+
+Nnue::Evaluator::Evaluator(const Network &network, Isa isa)
+    : m_network(network)
+    , m_isa(isSupported(isa) ? isa : Isa::Scalar)
+    , m_kernels(&kernels(m_isa))
+    , m_stack(STACK_SIZE)
+{
+}
+
+void Nnue::Evaluator::refresh(const Board &board, Accumulator &acc) const
+{
+    for (int p = 0; p < 2; ++p)
+    {
+        std::memcpy(acc.values[p], m_network.ftBias(), sizeof(acc.values[p]));
+
+        Bitboard occ = board.occupied();
+        while (occ.any())
+        {
+            const Square sq = occ.popLsb();
+            const Piece &piece = board.pieceAt(sq);
+            const int f = featureIndex(PERSPECTIVES[p], piece.color, piece.kind, sq);
+            m_kernels->addWeights(acc.values[p], m_network.ftWeights(f), HIDDEN);
+        }
+    }
+}
+
+void Nnue::Evaluator::reset(const Board &board)
+{
+    m_top = 0;
+    refresh(board, m_stack[0]);
+}
+
+void Nnue::Evaluator::push(const Board &after, PackedMove move, const UndoInfo &undo)
+{
+    const Accumulator &prev = m_stack[m_top];
+    Accumulator &next = m_stack[++m_top];
+
+    const Square from  = move.from();
+    const Square to    = move.to();
+    const Piece &mover = after.pieceAt(to);
+
+    for (int p = 0; p < 2; ++p)
+    {
+        const PieceColor persp = PERSPECTIVES[p];
+        std::int16_t *acc = next.values[p];
+        std::memcpy(acc, prev.values[p], sizeof(next.values[p]));
+
+        m_kernels->subWeights(acc, m_network.ftWeights(featureIndex(persp, mover.color, mover.kind, from)), HIDDEN);
+        m_kernels->addWeights(acc, m_network.ftWeights(featureIndex(persp, mover.color, mover.kind, to)), HIDDEN);
+
+        if (!undo.captured.isEmpty())
+        {
+            const Piece &cap = undo.captured;
+            m_kernels->subWeights(acc, m_network.ftWeights(featureIndex(persp, cap.color, cap.kind, to)), HIDDEN);
+        }
+
+        if (undo.rookFrom != NO_SQUARE)
+        {
+            m_kernels->subWeights(acc, m_network.ftWeights(featureIndex(persp, mover.color, PieceKind::Rook, undo.rookFrom)), HIDDEN);
+            m_kernels->addWeights(acc, m_network.ftWeights(featureIndex(persp, mover.color, PieceKind::Rook, undo.rookTo)), HIDDEN);
+        }
+    }
+}
+
+int Nnue::Evaluator::evaluate(const Accumulator &acc, PieceColor sideToMove) const
+{
+    // Вход плотных слоёв: сначала аккумулятор стороны хода
+    alignas(64) std::int16_t ordered[2 * HIDDEN];
+    const int us = (sideToMove == PieceColor::White) ? 0 : 1;
+    std::memcpy(ordered,          acc.values[us],     sizeof(acc.values[us]));
+    std::memcpy(ordered + HIDDEN, acc.values[1 - us], sizeof(acc.values[1 - us]));
+
+    alignas(64) std::uint8_t input[2 * HIDDEN];
+    m_kernels->clippedRelu(ordered, input, 2 * HIDDEN);
+
+    alignas(64) std::int16_t hidden[L1_OUT];
+    for (int i = 0; i < L1_OUT; ++i)
+    {
+        const std::int32_t sum = m_kernels->dot(input, m_network.l1Weights(i), 2 * HIDDEN) + m_network.l1Bias()[i];
+        // Арифметический сдвиг отрицательных: делим с округлением вниз
+        const std::int32_t v = sum >= 0 ? (sum >> L1_SHIFT) : -((-sum + (1 << L1_SHIFT) - 1) >> L1_SHIFT);
+        hidden[i] = static_cast<std::int16_t>(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+    }
+
+    alignas(64) std::uint8_t hiddenOut[L1_OUT];
+    m_kernels->clippedRelu(hidden, hiddenOut, L1_OUT);
+
+    const std::int32_t out = m_kernels->dot(hiddenOut, m_network.l2Weights(), L1_OUT) + m_network.l2Bias();
+    return out / OUTPUT_SCALE;
+}
+
+int Nnue::Evaluator::evaluate(const Board &board) const
+{
+    return evaluate(m_stack[m_top], board.sideToMove());
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+#include "NnueKernels.hpp"
+
+/**
+ * Эффективно обновляемая нейросетевая оценка (NNUE) для Omega Chess.
+ *
+ * Архитектура:
+ *  - вход: разреженные признаки (цвет относительно стороны, тип, клетка)
+ *    — 2 × 8 × 104 = 1664, отдельно с точки зрения белых и чёрных
+ *    (для чёрных клетка отражается, цвета меняются местами);
+ *  - слой признаков 1664 → 128 (int16), его выходы — «аккумуляторы»,
+ *    которые при ходе обновляются прибавлением/вычитанием строк весов;
+ *  - [свой аккумулятор, чужой] → clipped ReLU → 256 → 32 (int8 × uint8)
+ *    → clipped ReLU → 32 → 1.
+ *
+ * Веса читаются из бинарного файла с версией (см. Network) через mmap,
+ * без копирования.
+ */
+namespace Nnue
+{
+    constexpr int FEATURES = 2 * 8 * SQUARE_COUNT;
+    constexpr int HIDDEN   = 128;
+    constexpr int L1_OUT   = 32;
+
+    constexpr std::uint32_t FILE_VERSION = 1;
+
+    // Глубина стека аккумуляторов (полуходов от корня)
+    constexpr int STACK_SIZE = 128;
+
+    /**
+     * Веса сети.
+     *
+     * Формат файла (little-endian):
+     *  - заголовок 64 байта: "OMEGANN\0", версия (uint32), FEATURES,
+     *    HIDDEN, L1_OUT (uint32), остальное — нули;
+     *  - int16 ftBias[HIDDEN], int16 ftWeights[FEATURES][HIDDEN];
+     *  - int32 l1Bias[L1_OUT], int8 l1Weights[L1_OUT][2 * HIDDEN];
+     *  - int32 l2Bias, int8 l2Weights[L1_OUT].
+     * Все секции выровнены не хуже чем на 4 байта.
+     */
+    class Network
+    {
+    public:
+        static constexpr std::size_t HEADER_SIZE = 64;
+
+        Network() = default;
+
+        // Загрузить из файла (mmap); false — нет файла, чужой формат или версия
+        bool load(const std::string &path);
+
+        // Записать в файл в том же формате
+        bool save(const std::string &path) const;
+
+        // Случайные веса (для тестов и бенчмарков), в памяти
+        static Network random(std::uint32_t seed);
+
+        bool isLoaded() const noexcept { return m_ftWeights != nullptr; }
+
+        static std::size_t fileSize() noexcept;
+
+        const std::int16_t *ftBias()    const noexcept { return m_ftBias; }
+        const std::int16_t *ftWeights(int feature) const noexcept { return m_ftWeights + feature * HIDDEN; }
+        const std::int32_t *l1Bias()    const noexcept { return m_l1Bias; }
+        const std::int8_t  *l1Weights(int out) const noexcept { return m_l1Weights + out * 2 * HIDDEN; }
+        std::int32_t        l2Bias()    const noexcept { return *m_l2Bias; }
+        const std::int8_t  *l2Weights() const noexcept { return m_l2Weights; }
+
+    private:
+        // Разобрать заголовок и расставить указатели на секции data
+        bool bind(const std::uint8_t *data, std::size_t size);
+
+        MappedFile                m_file;     // источник весов: файл…
+        std::vector<std::uint8_t> m_buffer;   // …или память
+
+        const std::int16_t *m_ftBias    = nullptr;
+        const std::int16_t *m_ftWeights = nullptr;
+        const std::int32_t *m_l1Bias    = nullptr;
+        const std::int8_t  *m_l1Weights = nullptr;
+        const std::int32_t *m_l2Bias    = nullptr;
+        const std::int8_t  *m_l2Weights = nullptr;
+    };
+
+    struct alignas(64) Accumulator
+    {
+        std::int16_t values[2][HIDDEN];   // [0] — с точки зрения белых, [1] — чёрных
+    };
+
+    /**
+     * Оценщик: стек аккумуляторов вдоль текущего варианта.
+     *
+     * reset() считает аккумулятор корня с нуля; push() после
+     * Board::makeMove строит следующий из предыдущего по изменившимся
+     * фигурам (ушедшая, пришедшая, взятая, ладья при рокировке);
+     * pop() перед/после unmakeMove просто возвращается на уровень назад.
+     */
+    class Evaluator
+    {
+    public:
+        explicit Evaluator(const Network &network, Isa isa = detectIsa());
+
+        Isa isa() const noexcept { return m_isa; }
+
+        void reset(const Board &board);
+        void push(const Board &after, PackedMove move, const UndoInfo &undo);
+        void pop() noexcept { --m_top; }
+
+        // Оценка вершины стека с точки зрения стороны хода, в сантипешках
+        int evaluate(const Board &board) const;
+
+        // Аккумулятор позиции, посчитанный с нуля (эталон для проверки)
+        void refresh(const Board &board, Accumulator &acc) const;
+        int  evaluate(const Accumulator &acc, PieceColor sideToMove) const;
+
+        const Accumulator &current() const noexcept { return m_stack[m_top]; }
+
+    private:
+        const Network &m_network;
+        Isa            m_isa;
+        const Kernels *m_kernels;
+
+        std::vector<Accumulator> m_stack;
+        int                      m_top = 0;
+    };
+
+    // Индекс признака фигуры с точки зрения perspective
+    int featureIndex(PieceColor perspective, PieceColor color, PieceKind kind, Square sq) noexcept;
+}
@@ -0,0 +1,247 @@
+#include "NnueKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OMEGA_NNUE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// На GCC/Clang векторные функции помечаются своим набором инструкций;
+// MSVC собирает интринсики без дополнительных флагов
+#if defined(OMEGA_NNUE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define OMEGA_TARGET_AVX2  __attribute__((target("avx2")))
+#define OMEGA_TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define OMEGA_TARGET_AVX2
+#define OMEGA_TARGET_SSE41
+#endif
+
+namespace
+{
+    // -----------------------------------------------------------------
+    // Скалярные ядра (эталон)
+    // -----------------------------------------------------------------
+
+    void addWeightsScalar(std::int16_t *acc, const std::int16_t *w, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            acc[i] = static_cast<std::int16_t>(acc[i] + w[i]);
+    }
+
+    void subWeightsScalar(std::int16_t *acc, const std::int16_t *w, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            acc[i] = static_cast<std::int16_t>(acc[i] - w[i]);
+    }
+
+    void clippedReluScalar(const std::int16_t *in, std::uint8_t *out, int n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const int v = in[i];
+            out[i] = static_cast<std::uint8_t>(v < 0 ? 0 : (v > 127 ? 127 : v));
+        }
+    }
+
+    std::int32_t dotScalar(const std::uint8_t *in, const std::int8_t *w, int n)
+    {
+        std::int32_t sum = 0;
+        for (int i = 0; i < n; ++i)
+            sum += static_cast<std::int32_t>(in[i]) * w[i];
+        return sum;
+    }
+
+#ifdef OMEGA_NNUE_X86
+
+    // -----------------------------------------------------------------
+    // SSE4.1: 8 × int16 / 16 × int8 за операцию
+    // -----------------------------------------------------------------
+
+    OMEGA_TARGET_SSE41
+    void addWeightsSse41(std::int16_t *acc, const std::int16_t *w, int n)
+    {
+        for (int i = 0; i < n; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i));
+            a = _mm_add_epi16(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + i), a);
+        }
+    }
+
+    OMEGA_TARGET_SSE41
+    void subWeightsSse41(std::int16_t *acc, const std::int16_t *w, int n)
+    {
+        for (int i = 0; i < n; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i));
+            a = _mm_sub_epi16(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + i), a);
+        }
+    }
+
+    OMEGA_TARGET_SSE41
+    void clippedReluSse41(const std::int16_t *in, std::uint8_t *out, int n)
+    {
+        const __m128i limit = _mm_set1_epi16(127);
+        for (int i = 0; i < n; i += 16)
+        {
+            const __m128i a = _mm_min_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), limit);
+            const __m128i b = _mm_min_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 8)), limit);
+            // packus обрезает отрицательные до 0
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(a, b));
+        }
+    }
+
+    OMEGA_TARGET_SSE41
+    std::int32_t dotSse41(const std::uint8_t *in, const std::int8_t *w, int n)
+    {
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < n; i += 16)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i));
+            // 127 * 127 * 2 < 32767 — попарные суммы int16 не насыщаются
+            const __m128i p = _mm_maddubs_epi16(x, y);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(p, ones));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+        return _mm_cvtsi128_si32(sum);
+    }
+
+    // -----------------------------------------------------------------
+    // AVX2: 16 × int16 / 32 × int8 за операцию
+    // -----------------------------------------------------------------
+
+    OMEGA_TARGET_AVX2
+    void addWeightsAvx2(std::int16_t *acc, const std::int16_t *w, int n)
+    {
+        for (int i = 0; i < n; i += 16)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + i));
+            a = _mm256_add_epi16(a, b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + i), a);
+        }
+    }
+
+    OMEGA_TARGET_AVX2
+    void subWeightsAvx2(std::int16_t *acc, const std::int16_t *w, int n)
+    {
+        for (int i = 0; i < n; i += 16)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + i));
+            a = _mm256_sub_epi16(a, b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + i), a);
+        }
+    }
+
+    OMEGA_TARGET_AVX2
+    void clippedReluAvx2(const std::int16_t *in, std::uint8_t *out, int n)
+    {
+        const __m256i limit = _mm256_set1_epi16(127);
+        for (int i = 0; i < n; i += 32)
+        {
+            const __m256i a = _mm256_min_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), limit);
+            const __m256i b = _mm256_min_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 16)), limit);
+            // packus работает по 128-битным половинам — возвращаем порядок
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), packed);
+        }
+    }
+
+    OMEGA_TARGET_AVX2
+    std::int32_t dotAvx2(const std::uint8_t *in, const std::int8_t *w, int n)
+    {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i sum = _mm256_setzero_si256();
+        for (int i = 0; i < n; i += 32)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + i));
+            const __m256i p = _mm256_maddubs_epi16(x, y);
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(p, ones));
+        }
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+        return _mm_cvtsi128_si32(s);
+    }
+
+#endif
+
+    const Nnue::Kernels SCALAR = {addWeightsScalar, subWeightsScalar, clippedReluScalar, dotScalar};
+
+#ifdef OMEGA_NNUE_X86
+    const Nnue::Kernels SSE41 = {addWeightsSse41, subWeightsSse41, clippedReluSse41, dotSse41};
+    const Nnue::Kernels AVX2  = {addWeightsAvx2,  subWeightsAvx2,  clippedReluAvx2,  dotAvx2};
+#endif
+}
+
+bool Nnue::isSupported(Isa isa) noexcept
+{
+    if (isa == Isa::Scalar)
+        return true;
+
+#if defined(OMEGA_NNUE_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (isa == Isa::Avx2)
+        return __builtin_cpu_supports("avx2");
+    return __builtin_cpu_supports("sse4.1");
+#elif defined(OMEGA_NNUE_X86) && defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    const int maxLeaf = regs[0];
+
+    __cpuid(regs, 1);
+    const bool sse41   = (regs[2] & (1 << 19)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    if (isa == Isa::Sse41)
+        return sse41;
+
+    if (maxLeaf < 7 || !osxsave || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+Nnue::Isa Nnue::detectIsa() noexcept
+{
+    if (isSupported(Isa::Avx2))
+        return Isa::Avx2;
+    if (isSupported(Isa::Sse41))
+        return Isa::Sse41;
+    return Isa::Scalar;
+}
+
+const char *Nnue::isaName(Isa isa) noexcept
+{
+    switch (isa)
+    {
+    case Isa::Avx2:  return "AVX2";
+    case Isa::Sse41: return "SSE4.1";
+    default:         return "скалярный";
+    }
+}
+
+const Nnue::Kernels &Nnue::kernels(Isa isa) noexcept
+{
+#ifdef OMEGA_NNUE_X86
+    if (isa == Isa::Avx2)
+        return AVX2;
+    if (isa == Isa::Sse41)
+        return SSE41;
+#else
+    (void)isa;
+#endif
+    return SCALAR;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Вычислительные ядра NNUE-оценки в трёх вариантах: AVX2, SSE4.1 и
+ * скалярный. Вариант выбирается во время выполнения по возможностям
+ * процессора (detectIsa); все три дают побитно одинаковый результат.
+ *
+ * Векторные варианты собираются с атрибутами target, так что весь
+ * проект не требует флагов -mavx2/-msse4.1 и запускается на любом x86-64.
+ */
+namespace Nnue
+{
+    enum class Isa
+    {
+        Scalar,
+        Sse41,
+        Avx2
+    };
+
+    // Лучший вариант, поддерживаемый процессором
+    Isa detectIsa() noexcept;
+
+    // Поддерживает ли процессор вариант isa
+    bool isSupported(Isa isa) noexcept;
+
+    const char *isaName(Isa isa) noexcept;
+
+    struct Kernels
+    {
+        // acc[i] += w[i] / acc[i] -= w[i], i < n (n кратно 16)
+        void (*addWeights)(std::int16_t *acc, const std::int16_t *w, int n);
+        void (*subWeights)(std::int16_t *acc, const std::int16_t *w, int n);
+
+        // out[i] = clamp(in[i], 0, 127), i < n (n кратно 32)
+        void (*clippedRelu)(const std::int16_t *in, std::uint8_t *out, int n);
+
+        // Σ in[i] * w[i], i < n (n кратно 32); in — 0..127, w — int8
+        std::int32_t (*dot)(const std::uint8_t *in, const std::int8_t *w, int n);
+    };
+
+    const Kernels &kernels(Isa isa) noexcept;
+}
@@ -0,0 +1,175 @@
+#include "PawnTable.hpp"
+#include "Attacks.hpp"
+
+#include <array>
+
+namespace
+{
+    using Table = std::array<Bitboard, SQUARE_COUNT>;
+
+    // Вертикали основного поля 1..10. Пешка может оказаться и в углу
+    // волшебника (вертикаль 0 или 11), взяв его там; дальше она не ходит
+    constexpr int FILE_COUNT = 10;
+
+    // Начальные горизонтали пешек
+    constexpr int WHITE_PAWN_ROW = 9;
+    constexpr int BLACK_PAWN_ROW = 2;
+
+    // Штрафы и бонусы (mg, eg)
+    constexpr Psqt::Score DOUBLED   = {-12, -22};
+    constexpr Psqt::Score ISOLATED  = {-10, -14};
+    constexpr Psqt::Score PROTECTED = {  8,  12};
+
+    // Бонус проходной по продвижению (0..8 горизонталей от начальной).
+    // Превращения нет, поэтому бонус скромнее шахматного: проходная
+    // ценна как угроза прорыва и опора для фигур
+    constexpr Psqt::Score PASSED[9] = {
+        { 0,  0}, { 4, 10}, { 8, 16}, {12, 24}, {18, 34},
+        {26, 48}, {36, 64}, {48, 84}, {48, 84}
+    };
+
+    constexpr Bitboard fileMask(int col)
+    {
+        Bitboard bb;
+        for (int row = 1; row <= 10; ++row)
+            bb.set(Squares::fromCell(row, col));
+        return bb;
+    }
+
+    constexpr std::array<Bitboard, FILE_COUNT + 2> makeFiles()
+    {
+        std::array<Bitboard, FILE_COUNT + 2> files{};
+        for (int col = 1; col <= FILE_COUNT; ++col)
+            files[col] = fileMask(col);
+        return files;
+    }
+
+    // Вертикали по индексу col (0 и 11 — пустые, для соседей крайних)
+    constexpr std::array<Bitboard, FILE_COUNT + 2> FILES = makeFiles();
+
+    // Клетки перед пешкой на её и соседних вертикалях (span = true)
+    // или только на её вертикали; белые идут к row = 1, чёрные — к row = 10
+    constexpr Table makeFront(PieceColor color, bool span)
+    {
+        Table table{};
+        const int dir = (color == PieceColor::White) ? -1 : 1;
+        for (int sq = 0; sq < SQUARE_COUNT; ++sq)
+        {
+            const int col = Squares::colOf(sq);
+            if (col < 1 || col > FILE_COUNT)
+                continue;
+
+            for (int row = Squares::rowOf(sq) + dir; row >= 1 && row <= 10; row += dir)
+            {
+                for (int c = col - 1; c <= col + 1; ++c)
+                {
+                    if ((c == col || span) && c >= 1 && c <= FILE_COUNT)
+                        table[sq].set(Squares::fromCell(row, c));
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr Table WHITE_FRONT = makeFront(PieceColor::White, false);
+    constexpr Table BLACK_FRONT = makeFront(PieceColor::Black, false);
+    constexpr Table WHITE_SPAN  = makeFront(PieceColor::White, true);
+    constexpr Table BLACK_SPAN  = makeFront(PieceColor::Black, true);
+
+    Psqt::Score evaluateSide(const Board &board, PieceColor us, Bitboard &passed) noexcept
+    {
+        const PieceColor them = (us == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+        const Bitboard ours   = board.pieces(us, PieceKind::Pawn);
+        const Bitboard theirs = board.pieces(them, PieceKind::Pawn);
+
+        const Table &front = (us == PieceColor::White) ? WHITE_FRONT : BLACK_FRONT;
+        const Table &span  = (us == PieceColor::White) ? WHITE_SPAN  : BLACK_SPAN;
+
+        Psqt::Score score;
+        Bitboard pawns = ours;
+        while (pawns.any())
+        {
+            const Square sq  = pawns.popLsb();
+            const int    col = Squares::colOf(sq);
+
+            // Пешка в углу волшебника заперта: ни вертикали, ни клеток впереди
+            if (col < 1 || col > FILE_COUNT)
+                continue;
+
+            // Задняя из сдвоенных: впереди на вертикали своя пешка
+            const bool doubled = (front[sq] & ours).any();
+            if (doubled)
+                score += DOUBLED;
+
+            if ((ours & (FILES[col - 1] | FILES[col + 1])).empty())
+                score += ISOLATED;
+
+            // Защищена своей пешкой: её бьют наши пешки (= атаки чужой пешки с sq)
+            if ((Attacks::pawn(them, sq) & ours).any())
+                score += PROTECTED;
+
+            if (!doubled && (span[sq] & theirs).empty())
+            {
+                passed.set(sq);
+                score += PASSED[Pawns::advancement(us, sq)];
+            }
+        }
+        return score;
+    }
+}
+
+int Pawns::advancement(PieceColor color, Square sq) noexcept
+{
+    const int row  = Squares::rowOf(sq);
+    const int rows = (color == PieceColor::White) ? WHITE_PAWN_ROW - row : row - BLACK_PAWN_ROW;
+
+    // Расстановка вручную может поставить пешку и позади начальной горизонтали
+    return rows < 0 ? 0 : (rows > 8 ? 8 : rows);
+}
+
+PawnEntry Pawns::analyze(const Board &board) noexcept
+{
+    PawnEntry entry;
+    entry.key   = board.pawnHash();
+    entry.score = evaluateSide(board, PieceColor::White, entry.passed[0])
+                - evaluateSide(board, PieceColor::Black, entry.passed[1]);
+    return entry;
+}
+
+// ---------------------------------------------------------------------
+// Таблица
+// ---------------------------------------------------------------------
+
+PawnTable::PawnTable(std::size_t entries)
+{
+    // Округляем вниз до степени двойки: индекс — младшие биты ключа
+    std::size_t count = 1;
+    while (count * 2 <= entries)
+        count *= 2;
+
+    m_entries.resize(count);
+    m_mask = count - 1;
+}
+
+void PawnTable::clear()
+{
+    for (PawnEntry &e : m_entries)
+        e = PawnEntry();
+    resetStats();
+}
+
+const PawnEntry &PawnTable::probe(const Board &board) noexcept
+{
+    const std::uint64_t key = board.pawnHash();
+    PawnEntry &entry = m_entries[key & m_mask];
+
+    ++m_probes;
+    if (entry.key == key)
+    {
+        ++m_hits;
+        return entry;
+    }
+
+    entry = Pawns::analyze(board);
+    return entry;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Bitboard.hpp"
+#include "Board.hpp"
+#include "Psqt.hpp"
+
+/**
+ * Пешечная структура и её кэш.
+ *
+ * Сдвоенные, изолированные, защищённые и проходные пешки зависят только
+ * от расстановки пешек. Она меняется редко, а разбирать её на поле
+ * шириной 10 (с первыми ходами пешек на 1–3 клетки) недёшево, поэтому
+ * результат — PawnEntry — кэшируется в PawnTable по пешечному ключу
+ * Zobrist (Board::pawnHash). Таблица своя у каждого потока поиска и
+ * обходится без синхронизации.
+ */
+struct PawnEntry
+{
+    std::uint64_t key = 0;
+    Psqt::Score   score;       // mg/eg с точки зрения белых
+    Bitboard      passed[2];   // проходные пешки: [0] — белых, [1] — чёрных
+
+    Bitboard passedPawns(PieceColor color) const noexcept
+    {
+        return passed[color == PieceColor::White ? 0 : 1];
+    }
+};
+
+namespace Pawns
+{
+    // Разобрать пешечную структуру с нуля
+    PawnEntry analyze(const Board &board) noexcept;
+
+    // На сколько горизонталей пешка цвета color продвинулась от начальной (0..8)
+    int advancement(PieceColor color, Square sq) noexcept;
+}
+
+class PawnTable
+{
+public:
+    static constexpr std::size_t DEFAULT_ENTRIES = 16384;   // степень двойки
+
+    explicit PawnTable(std::size_t entries = DEFAULT_ENTRIES);
+
+    // Запись для позиции: из таблицы или разобранная заново (и сохранённая)
+    const PawnEntry &probe(const Board &board) noexcept;
+
+    void clear();
+
+    // Счётчики обращений и попаданий (с последнего resetStats)
+    void resetStats() noexcept { m_probes = m_hits = 0; }
+    std::uint64_t probes() const noexcept { return m_probes; }
+    std::uint64_t hits()   const noexcept { return m_hits; }
+
+private:
+    // Пустая запись (ключ 0) совпадает с разбором позиции без пешек,
+    // так что отдельный признак занятости не нужен
+    std::vector<PawnEntry> m_entries;
+    std::uint64_t          m_mask = 0;
+
+    std::uint64_t m_probes = 0;
+    std::uint64_t m_hits   = 0;
+};
@@ -0,0 +1,449 @@
+#include "Search.hpp"
+#include "Clock.hpp"
+#include "Evaluate.hpp"
+#include "MoveGen.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Как часто (в узлах) проверять время и лимит узлов
+    constexpr std::uint64_t CHECK_INTERVAL = 2048;
+
+    // Сколько тихих ходов узла запоминать для штрафа в истории
+    constexpr int MAX_TRIED_QUIETS = 64;
+
+    bool isQuiet(const Board &board, PackedMove m) noexcept
+    {
+        return m.isCastling() || board.pieceAt(m.to()).isEmpty();
+    }
+
+    // Оценки мата хранятся в таблице относительно текущего узла,
+    // а не корня: одна и та же позиция встречается на разных ply
+    int scoreToTT(int score, int ply) noexcept
+    {
+        if (score >= SCORE_MATE - MAX_PLY)
+            return score + ply;
+        if (score <= -SCORE_MATE + MAX_PLY)
+            return score - ply;
+        return score;
+    }
+
+    int scoreFromTT(int score, int ply) noexcept
+    {
+        if (score >= SCORE_MATE - MAX_PLY)
+            return score - ply;
+        if (score <= -SCORE_MATE + MAX_PLY)
+            return score + ply;
+        return score;
+    }
+}
+
+Searcher::Searcher()
+    : m_ownTt(new TranspositionTable)
+    , m_tt(m_ownTt.get())
+{
+}
+
+Searcher::Searcher(TranspositionTable &shared, int threadIndex)
+    : m_tt(&shared)
+    , m_threadIndex(threadIndex)
+{
+}
+
+void Searcher::setHistory(const std::vector<std::uint64_t> &keys)
+{
+    m_gameKeys = keys;
+}
+
+void Searcher::setNetwork(const Nnue::Network *network)
+{
+    if (network && network->isLoaded())
+        m_nnue.reset(new Nnue::Evaluator(*network));
+    else
+        m_nnue.reset();
+}
+
+// ---------------------------------------------------------------------
+// Итеративное углубление
+// ---------------------------------------------------------------------
+
+SearchResult Searcher::search(const Board &board,
+                              const SearchLimits &limits,
+                              const InfoCallback &onIteration)
+{
+    m_tt->newSearch();
+    return iterate(board, limits, onIteration);
+}
+
+SearchResult Searcher::iterate(const Board &board,
+                               const SearchLimits &limits,
+                               const InfoCallback &onIteration)
+{
+    m_board  = board;
+    m_limits = limits;
+    if (m_nnue)
+        m_nnue->reset(m_board);
+    m_start  = std::chrono::steady_clock::now();
+    m_nodes.store(0, std::memory_order_relaxed);
+    m_prevPv.clear();
+
+    m_keys.reserve(m_gameKeys.size() + MAX_PLY + 1);
+    m_keys.assign(m_gameKeys.begin(), m_gameKeys.end());
+    m_keys.push_back(m_board.hash());
+
+    std::memset(m_killers, 0, sizeof(m_killers));
+    m_history.clear();
+    m_pawns.resetStats();
+    m_cutoffs          = 0;
+    m_firstMoveCutoffs = 0;
+
+    const int maxDepth = (limits.depth > 0 && limits.depth < MAX_PLY) ? limits.depth : MAX_PLY - 1;
+
+    SearchResult result;
+
+    for (int depth = 1; depth <= maxDepth; ++depth)
+    {
+        if (skipDepth(depth))
+            continue;
+
+        const int score = pvs(-SCORE_INFINITE, SCORE_INFINITE, depth, 0);
+
+        // Прерванная итерация не используется: её результат неполон
+        if (m_stop.load(std::memory_order_relaxed))
+            break;
+
+        result.bestMove = m_pvLength[0] > 0 ? m_pv[0][0] : PackedMove::none();
+        result.score    = score;
+        result.depth    = depth;
+        result.pv.assign(m_pv[0], m_pv[0] + m_pvLength[0]);
+
+        fillStats(result);
+
+        m_prevPv = result.pv;
+
+        if (onIteration)
+            onIteration(result);
+
+        // Ходов нет или найден мат — глубже искать незачем
+        if (result.bestMove.isNone() || isMateScore(score))
+            break;
+    }
+
+    // Прервано ещё на первой итерации — любой легальный ход лучше, чем никакого
+    if (result.depth == 0)
+    {
+        MoveList legal;
+        MoveGen::generateLegal(board, legal);
+        if (!legal.empty())
+        {
+            result.bestMove = legal[0];
+            result.pv.assign(1, legal[0]);
+        }
+    }
+
+    fillStats(result);
+    return result;
+}
+
+// ---------------------------------------------------------------------
+// Alpha-beta с главным вариантом
+// ---------------------------------------------------------------------
+
+int Searcher::pvs(int alpha, int beta, int depth, int ply)
+{
+    m_pvLength[ply] = ply;
+
+    const PieceColor us      = m_board.sideToMove();
+    const bool       inCheck = Rules::isKingInCheck(m_board, us);
+
+    // Продление шахов: уходы от шаха считаются на полную глубину
+    if (inCheck)
+        ++depth;
+
+    if (depth <= 0)
+        return quiescence(alpha, beta, ply);
+
+    countNode();
+    checkLimits();
+    if (m_stop.load(std::memory_order_relaxed))
+        return 0;
+
+    // Повторение и правило 50 ходов — ничья (в корне ход нужен всё равно).
+    // Мат сотым полуходом важнее правила 50 ходов, как в GameController
+    if (ply > 0 && isRepetition())
+        return 0;
+    if (ply > 0 && m_board.halfmoveClock() >= 100 && (!inCheck || MoveGen::hasLegalMove(m_board)))
+        return 0;
+
+    if (ply >= MAX_PLY - 1)
+        return evaluate();
+
+    const bool          pvNode  = (beta - alpha > 1);
+    const int           alphaIn = alpha;
+    const std::uint64_t key     = m_board.hash();
+
+    // Отсечение по таблице — только вне главного варианта, чтобы PV не обрывался
+    TranspositionTable::Entry entry;
+    const bool ttHit = m_tt->probe(key, entry);
+    if (ttHit && !pvNode && ply > 0 && entry.depth >= depth)
+    {
+        const int ttScore = scoreFromTT(entry.score, ply);
+        if (entry.bound == TranspositionTable::BoundExact ||
+            (entry.bound == TranspositionTable::BoundLower && ttScore >= beta) ||
+            (entry.bound == TranspositionTable::BoundUpper && ttScore <= alpha))
+        {
+            return ttScore;
+        }
+    }
+
+    // Первым — ход из таблицы, иначе ход главного варианта прошлой итерации
+    PackedMove hashMove = ttHit ? entry.move : PackedMove::none();
+    if (hashMove.isNone() && ply < static_cast<int>(m_prevPv.size()))
+        hashMove = m_prevPv[ply];
+
+    MovePicker picker(m_board, hashMove, m_killers[ply], m_history);
+
+    int        best     = -SCORE_INFINITE;
+    PackedMove bestMove = PackedMove::none();
+    int        legal    = 0;
+
+    PackedMove tried[MAX_TRIED_QUIETS];
+    int        triedCount = 0;
+
+    for (PackedMove m = picker.next(); !m.isNone(); m = picker.next())
+    {
+        const bool quiet = isQuiet(m_board, m);
+
+        UndoInfo undo;
+        m_board.makeMove(m, undo);
+        if (Rules::isKingInCheck(m_board, us))
+        {
+            m_board.unmakeMove(m, undo);
+            continue;
+        }
+        ++legal;
+        pushEval(m, undo);
+        m_keys.push_back(m_board.hash());
+
+        int score;
+        if (legal == 1)
+        {
+            score = -pvs(-beta, -alpha, depth - 1, ply + 1);
+        }
+        else
+        {
+            // Нулевое окно: достаточно доказать, что ход не лучше alpha
+            score = -pvs(-alpha - 1, -alpha, depth - 1, ply + 1);
+            if (score > alpha && score < beta)
+                score = -pvs(-beta, -alpha, depth - 1, ply + 1);
+        }
+
+        m_keys.pop_back();
+        popEval();
+        m_board.unmakeMove(m, undo);
+
+        if (m_stop.load(std::memory_order_relaxed))
+            return 0;
+
+        if (score > best)
+        {
+            best     = score;
+            bestMove = m;
+            if (score > alpha)
+            {
+                alpha = score;
+                updatePv(ply, m);
+                if (score >= beta)
+                {
+                    ++m_cutoffs;
+                    if (legal == 1)
+                        ++m_firstMoveCutoffs;
+
+                    if (quiet)
+                        updateQuietStats(ply, depth, m, tried, triedCount);
+                    break;
+                }
+            }
+        }
+
+        if (quiet && triedCount < MAX_TRIED_QUIETS)
+            tried[triedCount++] = m;
+    }
+
+    if (legal == 0)
+        return inCheck ? -SCORE_MATE + ply : 0;
+
+    const TranspositionTable::Bound bound =
+        best >= beta   ? TranspositionTable::BoundLower :
+        best > alphaIn ? TranspositionTable::BoundExact :
+                         TranspositionTable::BoundUpper;
+
+    // Ход без улучшения alpha не лучший наверняка — его не запоминаем
+    m_tt->store(key,
+                bound == TranspositionTable::BoundUpper ? PackedMove::none() : bestMove,
+                scoreToTT(best, ply), depth, bound);
+
+    return best;
+}
+
+// ---------------------------------------------------------------------
+// Поиск взятий
+// ---------------------------------------------------------------------
+
+int Searcher::quiescence(int alpha, int beta, int ply)
+{
+    m_pvLength[ply] = ply;
+
+    countNode();
+    checkLimits();
+    if (m_stop.load(std::memory_order_relaxed))
+        return 0;
+
+    const int standPat = evaluate();
+    if (ply >= MAX_PLY - 1 || standPat >= beta)
+        return standPat;
+
+    if (standPat > alpha)
+        alpha = standPat;
+
+    MovePicker picker(m_board);
+
+    const PieceColor us = m_board.sideToMove();
+    int best = standPat;
+
+    for (PackedMove m = picker.next(); !m.isNone(); m = picker.next())
+    {
+        UndoInfo undo;
+        m_board.makeMove(m, undo);
+        if (Rules::isKingInCheck(m_board, us))
+        {
+            m_board.unmakeMove(m, undo);
+            continue;
+        }
+
+        pushEval(m, undo);
+        const int score = -quiescence(-beta, -alpha, ply + 1);
+        popEval();
+        m_board.unmakeMove(m, undo);
+
+        if (m_stop.load(std::memory_order_relaxed))
+            return 0;
+
+        if (score > best)
+        {
+            best = score;
+            if (score > alpha)
+            {
+                alpha = score;
+                updatePv(ply, m);
+                if (score >= beta)
+                    break;
+            }
+        }
+    }
+
+    return best;
+}
+
+// ---------------------------------------------------------------------
+// Служебное
+// ---------------------------------------------------------------------
+
+void Searcher::updateQuietStats(int ply, int depth, PackedMove best,
+                                const PackedMove *tried, int triedCount) noexcept
+{
+    if (m_killers[ply][0] != best)
+    {
+        m_killers[ply][1] = m_killers[ply][0];
+        m_killers[ply][0] = best;
+    }
+
+    // Отсёкший ход — вверх, перебранные до него тихие — вниз
+    const PieceColor us    = m_board.sideToMove();
+    const int        bonus = depth * depth;
+
+    m_history.update(us, best, bonus);
+    for (int i = 0; i < triedCount; ++i)
+        m_history.update(us, tried[i], -bonus);
+}
+
+void Searcher::updatePv(int ply, PackedMove move) noexcept
+{
+    m_pv[ply][ply] = move;
+    for (int i = ply + 1; i < m_pvLength[ply + 1]; ++i)
+        m_pv[ply][i] = m_pv[ply + 1][i];
+    m_pvLength[ply] = m_pvLength[ply + 1];
+}
+
+void Searcher::checkLimits() noexcept
+{
+    const std::uint64_t n = nodes();
+    if (n % CHECK_INTERVAL != 0)
+        return;
+
+    if (m_limits.nodes > 0 && n >= m_limits.nodes)
+        m_stop.store(true, std::memory_order_relaxed);
+
+    if (m_limits.moveTimeMs > 0 &&
+        elapsedSeconds() * 1000.0 >= static_cast<double>(m_limits.moveTimeMs))
+    {
+        m_stop.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool Searcher::skipDepth(int depth) const noexcept
+{
+    // Схема пропусков Lazy SMP: вспомогательные потоки через раз
+    // перескакивают глубины (каждый со своим шагом и сдвигом), чтобы
+    // потоки не шли по дереву синхронно и наполняли общую таблицу
+    // разными позициями
+    static constexpr int SKIP_SIZE[]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    static constexpr int SKIP_PHASE[] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+    if (m_threadIndex == 0 || depth == 1)
+        return false;
+
+    const int i = (m_threadIndex - 1) % 20;
+    return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2 != 0;
+}
+
+void Searcher::fillStats(SearchResult &result) const
+{
+    result.nodes    = nodes();
+    result.seconds  = elapsedSeconds();
+    result.nps      = nodesPerSecond(result.nodes, result.seconds);
+    result.hashfull = m_tt->hashfull();
+
+    result.cutoffs          = m_cutoffs;
+    result.firstMoveCutoffs = m_firstMoveCutoffs;
+
+    result.pawnProbes = m_pawns.probes();
+    result.pawnHits   = m_pawns.hits();
+}
+
+bool Searcher::isRepetition() const noexcept
+{
+    // Та же сторона хода — через полуход; дальше последнего взятия
+    // или хода пешки позиции уже не повторяются
+    const int last  = static_cast<int>(m_keys.size()) - 1;
+    const int limit = std::max(0, last - m_board.halfmoveClock());
+    for (int i = last - 2; i >= limit; i -= 2)
+    {
+        if (m_keys[i] == m_keys[last])
+            return true;
+    }
+    return false;
+}
+
+int Searcher::evaluate()
+{
+    return m_nnue ? m_nnue->evaluate(m_board) : Eval::evaluate(m_board, m_pawns);
+}
+
+double Searcher::elapsedSeconds() const
+{
+    return secondsSince(m_start);
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "MovePicker.hpp"
+#include "Nnue.hpp"
+#include "PawnTable.hpp"
+#include "TranspositionTable.hpp"
+
+/**
+ * Поиск лучшего хода: итеративное углубление, alpha-beta с главным
+ * вариантом (PVS) и поиск взятий (quiescence) на листьях.
+ *
+ * Модуль не зависит от Qt: им пользуются и консольный omega_analyze,
+ * и GameController. Поиск идёт синхронно на копии доски; остановить
+ * его из другого потока можно через Searcher::stop().
+ *
+ * Searcher либо владеет собственной таблицей транспозиций, либо
+ * пользуется общей (несколько поисков на одну таблицу). Многопоточный
+ * поиск — ParallelSearch (SmpSearch.hpp).
+ *
+ * Листья оцениваются Eval::evaluate (PSQT) или, если задана сеть
+ * (setNetwork), NNUE-оценщиком с аккумуляторами вдоль варианта.
+ */
+
+constexpr int MAX_PLY        = 64;
+constexpr int SCORE_INFINITE = 32000;
+constexpr int SCORE_MATE     = 30000;   // мат на ply-м полуходе: SCORE_MATE - ply
+
+inline bool isMateScore(int score) noexcept
+{
+    return score >= SCORE_MATE - MAX_PLY || score <= -SCORE_MATE + MAX_PLY;
+}
+
+inline std::uint64_t nodesPerSecond(std::uint64_t nodes, double seconds) noexcept
+{
+    return seconds > 0.0 ? static_cast<std::uint64_t>(static_cast<double>(nodes) / seconds) : 0;
+}
+
+/// Ограничения поиска; нулевое значение — без ограничения
+struct SearchLimits
+{
+    int           depth      = 0;   // максимальная глубина (иначе до MAX_PLY - 1)
+    std::int64_t  moveTimeMs = 0;   // время на ход, мс
+    std::uint64_t nodes      = 0;   // число узлов
+};
+
+/// Итог завершённой итерации (и поиска в целом)
+struct SearchResult
+{
+    PackedMove    bestMove;         // none, если ходов нет
+    int           score   = 0;      // с точки зрения стороны хода
+    int           depth   = 0;      // последняя полностью просчитанная глубина
+    std::uint64_t nodes   = 0;
+    double        seconds = 0.0;
+    std::uint64_t nps     = 0;      // узлов в секунду
+    int           hashfull = 0;     // заполненность таблицы транспозиций, ‰
+
+    // Качество упорядочивания: сколько отсечений по beta в основном
+    // поиске случилось на первом же легальном ходе узла
+    // (у хорошего порядка — свыше 90%)
+    std::uint64_t cutoffs          = 0;
+    std::uint64_t firstMoveCutoffs = 0;
+
+    double firstMoveCutoffRate() const noexcept
+    {
+        return cutoffs > 0 ? static_cast<double>(firstMoveCutoffs) / static_cast<double>(cutoffs) : 0.0;
+    }
+
+    // Кэш пешечной структуры: обращения и попадания
+    std::uint64_t pawnProbes = 0;
+    std::uint64_t pawnHits   = 0;
+
+    double pawnHitRate() const noexcept
+    {
+        return pawnProbes > 0 ? static_cast<double>(pawnHits) / static_cast<double>(pawnProbes) : 0.0;
+    }
+
+    std::vector<PackedMove> pv;     // главный вариант, начиная с bestMove
+};
+
+class Searcher
+{
+public:
+    // Вызывается после каждой завершённой итерации
+    using InfoCallback = std::function<void(const SearchResult &)>;
+
+    Searcher();
+    // threadIndex > 0 — вспомогательный поток Lazy SMP (см. ParallelSearch)
+    explicit Searcher(TranspositionTable &shared, int threadIndex = 0);
+
+    TranspositionTable &tt() noexcept { return *m_tt; }
+
+    // Ключи Zobrist позиций партии до корневой (без неё), по порядку:
+    // повторение позиции из партии в дереве поиска считается ничьей
+    void setHistory(const std::vector<std::uint64_t> &keys);
+
+    // Оценивать сетью (nullptr — вернуться к PSQT); не во время поиска.
+    // Сеть должна жить дольше Searcher
+    void setNetwork(const Nnue::Network *network);
+
+    // Сбросить флаг остановки. Вызывается перед каждым search() в том
+    // потоке, который запускает поиск, до его старта: stop(), пришедший
+    // после prepare(), не теряется, даже если поиск ещё не начался
+    void prepare() noexcept { m_stop.store(false, std::memory_order_relaxed); }
+
+    // Поиск до лимитов или stop(); флаг остановки сам не сбрасывает — см. prepare()
+    SearchResult search(const Board &board,
+                        const SearchLimits &limits,
+                        const InfoCallback &onIteration = InfoCallback());
+
+    // Прервать идущий поиск (можно из другого потока)
+    void stop() noexcept { m_stop.store(true, std::memory_order_relaxed); }
+
+    // Узлы текущего (или последнего) поиска; можно читать из другого потока
+    std::uint64_t nodes() const noexcept { return m_nodes.load(std::memory_order_relaxed); }
+
+private:
+    friend class ParallelSearch;
+
+    // Итеративное углубление без сброса флага остановки и поколения таблицы
+    SearchResult iterate(const Board &board,
+                         const SearchLimits &limits,
+                         const InfoCallback &onIteration);
+
+    int pvs(int alpha, int beta, int depth, int ply);
+    int quiescence(int alpha, int beta, int ply);
+
+    void updatePv(int ply, PackedMove move) noexcept;
+    void updateQuietStats(int ply, int depth, PackedMove best,
+                          const PackedMove *tried, int triedCount) noexcept;
+    void fillStats(SearchResult &result) const;
+    void checkLimits() noexcept;
+    bool skipDepth(int depth) const noexcept;
+
+    // Счётчик пишет только свой поток; атомарность — ради чтения nodes() снаружи
+    void countNode() noexcept
+    {
+        m_nodes.store(m_nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    double elapsedSeconds() const;
+
+    // Текущая позиция уже встречалась (в партии или на пути от корня)
+    // после последнего необратимого хода — ничья
+    bool isRepetition() const noexcept;
+
+    // Статическая оценка m_board с точки зрения стороны хода
+    int evaluate();
+
+    // Сопровождение аккумуляторов NNUE вокруг make/unmake
+    void pushEval(PackedMove move, const UndoInfo &undo)
+    {
+        if (m_nnue)
+            m_nnue->push(m_board, move, undo);
+    }
+    void popEval() noexcept
+    {
+        if (m_nnue)
+            m_nnue->pop();
+    }
+
+    Board        m_board;
+    SearchLimits m_limits;
+
+    std::unique_ptr<TranspositionTable> m_ownTt;
+    TranspositionTable                 *m_tt = nullptr;
+    int                                 m_threadIndex = 0;
+
+    std::unique_ptr<Nnue::Evaluator> m_nnue;
+
+    std::atomic<bool>          m_stop{false};
+    std::atomic<std::uint64_t> m_nodes{0};
+
+    std::chrono::steady_clock::time_point m_start;
+
+    // Треугольная таблица главного варианта
+    PackedMove m_pv[MAX_PLY][MAX_PLY];
+    int        m_pvLength[MAX_PLY] = {};
+
+    // Ключи позиций партии и пути от корня; последний — текущая позиция.
+    // Память резервируется в iterate(), в поиске без выделений
+    std::vector<std::uint64_t> m_gameKeys;
+    std::vector<std::uint64_t> m_keys;
+
+    // Главный вариант предыдущей итерации: его ходы пробуются первыми
+    std::vector<PackedMove> m_prevPv;
+
+    // Упорядочивание ходов (у каждого потока своё)
+    PackedMove   m_killers[MAX_PLY][2];
+    HistoryTable m_history;
+
+    // Кэш пешечной структуры (у каждого потока свой); между поисками не очищается
+    PawnTable m_pawns;
+
+    std::uint64_t m_cutoffs          = 0;
+    std::uint64_t m_firstMoveCutoffs = 0;
+};
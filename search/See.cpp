@@ -0,0 +1,118 @@
+#include "See.hpp"
+#include "Attacks.hpp"
+#include "Evaluate.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Порядок выбора бьющей фигуры: от самой дешёвой, король — последним
+    constexpr PieceKind CHEAPEST_FIRST[] = {
+        PieceKind::Pawn,
+        PieceKind::Knight,
+        PieceKind::Bishop,
+        PieceKind::Wizard,
+        PieceKind::Champion,
+        PieceKind::Rook,
+        PieceKind::Queen,
+        PieceKind::King
+    };
+
+    // Самая дешёвая фигура из attackers; kind — её тип
+    Square leastValuable(const Board &board, Bitboard attackers, PieceKind &kind)
+    {
+        for (PieceKind k : CHEAPEST_FIRST)
+        {
+            const Bitboard set = attackers & board.pieces(k);
+            if (set.any())
+            {
+                kind = k;
+                return set.lsb();
+            }
+        }
+        return NO_SQUARE;
+    }
+
+    PieceColor opposite(PieceColor c)
+    {
+        return (c == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+    }
+}
+
+int See::evaluate(const Board &board, PackedMove move)
+{
+    if (move.isCastling())
+        return 0;
+
+    const Square from = move.from();
+    const Square to   = move.to();
+
+    const Piece &victim = board.pieceAt(to);
+    if (victim.isEmpty())
+        return 0;
+
+    // gain[d] — выигрыш стороны, бьющей d-й раз, если дальше никто не бьёт
+    int gain[32];
+    int d = 0;
+    gain[0] = Eval::pieceValue(victim.kind);
+
+    PieceKind  onSquare = board.pieceAt(from).kind;   // кто сейчас стоит на to
+    PieceColor side     = board.pieceAt(from).color;
+
+    Bitboard occupied = board.occupied();
+    occupied.reset(from);
+
+    const Bitboard queens     = board.pieces(PieceKind::Queen);
+    const Bitboard rookLike   = board.pieces(PieceKind::Rook)   | queens;
+    const Bitboard bishopLike = board.pieces(PieceKind::Bishop) | queens;
+
+    Bitboard attackers = Rules::attackersTo(board, to, occupied);
+
+    for (;;)
+    {
+        // Короля не берут: на нём размен заканчивается
+        if (onSquare == PieceKind::King)
+            break;
+
+        side = opposite(side);
+
+        const Bitboard ours = attackers & board.pieces(side);
+        if (ours.empty())
+            break;
+
+        PieceKind    kind = PieceKind::None;
+        const Square sq   = leastValuable(board, ours, kind);
+
+        // Король не бьёт на защищённую клетку
+        if (kind == PieceKind::King && (attackers & board.pieces(opposite(side))).any())
+            break;
+
+        ++d;
+        gain[d] = Eval::pieceValue(onSquare) - gain[d - 1];
+
+        onSquare = kind;
+        occupied.reset(sq);
+
+        // Открылись ли скользящие фигуры за снятой
+        attackers |= (Attacks::rook(to, occupied)   & rookLike) |
+                     (Attacks::bishop(to, occupied) & bishopLike);
+        attackers &= occupied;
+
+        if (d == 31)
+            break;
+    }
+
+    // Свёртка: каждая сторона выбирает, бить или остановиться
+    while (d > 0)
+    {
+        gain[d - 1] = -std::max(-gain[d - 1], gain[d]);
+        --d;
+    }
+    return gain[0];
+}
+
+bool See::atLeast(const Board &board, PackedMove move, int threshold)
+{
+    return evaluate(board, move) >= threshold;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * Статическая оценка размена (SEE) на одной клетке.
+ *
+ * Для взятия move считает материальный итог серии взятий на клетке
+ * назначения, если обе стороны каждый раз бьют самой дешёвой фигурой
+ * и могут остановиться, когда продолжать невыгодно. Доска не меняется:
+ * размен ведётся на битбордах через Rules::attackersTo, из занятости
+ * по очереди «снимаются» бьющие фигуры.
+ *
+ * Скользящие фигуры за снятой фигурой открываются (рентген), прыгающие
+ * (конь, чемпион, волшебник) ничего не открывают. Король бьёт последним
+ * и только если соперник больше не может бить. Связки не учитываются.
+ */
+namespace See
+{
+    // Итог размена в сантипешках с точки зрения стороны, делающей ход;
+    // для тихих ходов и рокировки — 0
+    int evaluate(const Board &board, PackedMove move);
+
+    // evaluate(board, move) >= threshold
+    bool atLeast(const Board &board, PackedMove move, int threshold);
+}
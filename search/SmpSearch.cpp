@@ -0,0 +1,106 @@
+#include "SmpSearch.hpp"
+
+#include <thread>
+
+ParallelSearch::ParallelSearch(int threads, std::size_t hashMb)
+    : m_tt(hashMb)
+{
+    setThreadCount(threads);
+}
+
+ParallelSearch::~ParallelSearch() = default;
+
+void ParallelSearch::setThreadCount(int threads)
+{
+    if (threads < 1)
+        threads = 1;
+
+    m_searchers.clear();
+    for (int i = 0; i < threads; ++i)
+    {
+        m_searchers.emplace_back(new Searcher(m_tt, i));
+        m_searchers.back()->setNetwork(m_network);
+        m_searchers.back()->setHistory(m_history);
+    }
+}
+
+void ParallelSearch::setHistory(const std::vector<std::uint64_t> &keys)
+{
+    m_history = keys;
+    for (auto &s : m_searchers)
+        s->setHistory(keys);
+}
+
+void ParallelSearch::setNetwork(const Nnue::Network *network)
+{
+    m_network = network;
+    for (auto &s : m_searchers)
+        s->setNetwork(network);
+}
+
+SearchResult ParallelSearch::search(const Board &board,
+                                    const SearchLimits &limits,
+                                    const Searcher::InfoCallback &onIteration)
+{
+    m_tt.newSearch();
+
+    // Вспомогательные потоки ищут без лимитов, пока их не остановит главный
+    std::vector<std::thread> helpers;
+    helpers.reserve(m_searchers.size() - 1);
+    for (std::size_t i = 1; i < m_searchers.size(); ++i)
+    {
+        Searcher *helper = m_searchers[i].get();
+        helpers.emplace_back([helper, &board]() {
+            helper->iterate(board, SearchLimits(), Searcher::InfoCallback());
+        });
+    }
+
+    // Вывод итераций — с суммарным числом узлов
+    Searcher::InfoCallback report;
+    if (onIteration)
+    {
+        report = [this, &onIteration](const SearchResult &r) {
+            SearchResult total = r;
+            total.nodes = totalNodes();
+            total.nps   = nodesPerSecond(total.nodes, total.seconds);
+            onIteration(total);
+        };
+    }
+
+    SearchResult result = m_searchers[0]->iterate(board, limits, report);
+
+    stop();
+    for (std::thread &t : helpers)
+        t.join();
+
+    result.nodes = totalNodes();
+    result.nps   = nodesPerSecond(result.nodes, result.seconds);
+
+    // Потоки остановлены — их счётчики кэша пешек можно сложить
+    for (std::size_t i = 1; i < m_searchers.size(); ++i)
+    {
+        result.pawnProbes += m_searchers[i]->m_pawns.probes();
+        result.pawnHits   += m_searchers[i]->m_pawns.hits();
+    }
+    return result;
+}
+
+void ParallelSearch::prepare() noexcept
+{
+    for (auto &s : m_searchers)
+        s->prepare();
+}
+
+void ParallelSearch::stop() noexcept
+{
+    for (auto &s : m_searchers)
+        s->stop();
+}
+
+std::uint64_t ParallelSearch::totalNodes() const noexcept
+{
+    std::uint64_t sum = 0;
+    for (const auto &s : m_searchers)
+        sum += s->nodes();
+    return sum;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+
+/**
+ * Многопоточный поиск в стиле Lazy SMP.
+ *
+ * Все потоки ищут одну и ту же позицию независимо, каждый со своей
+ * копией доски и своими стеками (отдельный Searcher), и общаются только
+ * через общую таблицу транспозиций без блокировок. Вспомогательные
+ * потоки пропускают часть глубин, чтобы расходиться по дереву.
+ *
+ * Результат, лимиты и вывод итераций — от главного потока (индекс 0);
+ * когда он заканчивает, остальные останавливаются. Узлы, скорость и
+ * счётчики кэша пешек в итоговом результате — суммарные по всем потокам.
+ */
+class ParallelSearch
+{
+public:
+    explicit ParallelSearch(int threads = 1,
+                            std::size_t hashMb = TranspositionTable::DEFAULT_MB);
+    ~ParallelSearch();
+
+    ParallelSearch(const ParallelSearch &) = delete;
+    ParallelSearch &operator=(const ParallelSearch &) = delete;
+
+    // Число потоков (не меньше 1); не во время поиска
+    void setThreadCount(int threads);
+    int  threadCount() const noexcept { return static_cast<int>(m_searchers.size()); }
+
+    TranspositionTable &tt() noexcept { return m_tt; }
+
+    // Ключи позиций партии до корневой; см. Searcher::setHistory
+    void setHistory(const std::vector<std::uint64_t> &keys);
+
+    // Оценка сетью во всех потоках (nullptr — PSQT); см. Searcher::setNetwork
+    void setNetwork(const Nnue::Network *network);
+
+    // Сбросить флаги остановки всех потоков; см. Searcher::prepare.
+    // Поиск в отдельном потоке: prepare() — до запуска этого потока
+    void prepare() noexcept;
+
+    SearchResult search(const Board &board,
+                        const SearchLimits &limits,
+                        const Searcher::InfoCallback &onIteration = Searcher::InfoCallback());
+
+    // Прервать идущий поиск (можно из другого потока)
+    void stop() noexcept;
+
+private:
+    std::uint64_t totalNodes() const noexcept;
+
+    TranspositionTable                     m_tt;
+    const Nnue::Network                   *m_network = nullptr;
+    std::vector<std::uint64_t>             m_history;
+    std::vector<std::unique_ptr<Searcher>> m_searchers;
+};
@@ -0,0 +1,167 @@
+#include "TranspositionTable.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Упаковка записи в 64 бита:
+    //  - биты 0..15  — ход (PackedMove::raw)
+    //  - биты 16..31 — оценка (int16)
+    //  - биты 32..39 — глубина
+    //  - биты 40..41 — тип оценки (Bound)
+    //  - биты 42..47 — поколение (номер поиска по модулю 64)
+    constexpr int GENERATION_MASK = 0x3F;
+
+    std::uint64_t pack(PackedMove move, int score, int depth,
+                       TranspositionTable::Bound bound, int generation) noexcept
+    {
+        return  static_cast<std::uint64_t>(move.raw())
+             | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << 16)
+             | (static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << 32)
+             | (static_cast<std::uint64_t>(bound) << 40)
+             | (static_cast<std::uint64_t>(generation & GENERATION_MASK) << 42);
+    }
+
+    PackedMove moveOf(std::uint64_t data) noexcept
+    {
+        return PackedMove::fromRaw(static_cast<std::uint16_t>(data));
+    }
+
+    int scoreOf(std::uint64_t data) noexcept
+    {
+        return static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> 16));
+    }
+
+    int depthOf(std::uint64_t data) noexcept
+    {
+        return static_cast<std::uint8_t>(data >> 32);
+    }
+
+    TranspositionTable::Bound boundOf(std::uint64_t data) noexcept
+    {
+        return static_cast<TranspositionTable::Bound>((data >> 40) & 3);
+    }
+
+    int generationOf(std::uint64_t data) noexcept
+    {
+        return static_cast<int>((data >> 42) & GENERATION_MASK);
+    }
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes)
+{
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes)
+{
+    if (megabytes == 0)
+        megabytes = 1;
+
+    const std::size_t maxBuckets = megabytes * 1024 * 1024 / sizeof(Bucket);
+
+    std::size_t count = 1;
+    while (count * 2 <= maxBuckets)
+        count *= 2;
+
+    m_buckets.reset(new Bucket[count]);
+    m_bucketCount = count;
+    m_megabytes   = megabytes;
+    m_generation  = 0;
+}
+
+void TranspositionTable::clear() noexcept
+{
+    for (std::size_t i = 0; i < m_bucketCount; ++i)
+    {
+        for (Slot &slot : m_buckets[i].entries)
+        {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_generation = 0;
+}
+
+void TranspositionTable::newSearch() noexcept
+{
+    m_generation = static_cast<std::uint8_t>((m_generation + 1) & GENERATION_MASK);
+}
+
+bool TranspositionTable::probe(std::uint64_t key, Entry &out) const noexcept
+{
+    const Bucket &bucket = bucketFor(key);
+
+    for (const Slot &slot : bucket.entries)
+    {
+        const std::uint64_t data  = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) != key || data == 0)
+            continue;
+
+        out.move  = moveOf(data);
+        out.score = scoreOf(data);
+        out.depth = depthOf(data);
+        out.bound = boundOf(data);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, PackedMove move, int score, int depth, Bound bound) noexcept
+{
+    Bucket &bucket = bucketFor(key);
+
+    // Своя запись — перезаписываем её; иначе вытесняем самую «дешёвую»:
+    // мелкую и из давних поисков
+    Slot *victim      = nullptr;
+    int   victimValue = 0;
+
+    for (Slot &slot : bucket.entries)
+    {
+        const std::uint64_t data  = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) == key && data != 0)
+        {
+            // Ход без лучшего хода не должен затирать известный
+            if (move.isNone())
+                move = moveOf(data);
+            victim = &slot;
+            break;
+        }
+
+        const int age   = (m_generation - generationOf(data)) & GENERATION_MASK;
+        const int value = data == 0 ? -1024 : depthOf(data) - 8 * age;
+        if (!victim || value < victimValue)
+        {
+            victim      = &slot;
+            victimValue = value;
+        }
+    }
+
+    const std::uint64_t data = pack(move, score, depth, bound, m_generation);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+    victim->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const noexcept
+{
+    // Первые 1000 записей (250 корзин) — достаточная выборка
+    const std::size_t buckets = std::min<std::size_t>(m_bucketCount, 1000 / BUCKET_SIZE);
+
+    int used = 0;
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+        for (const Slot &slot : m_buckets[i].entries)
+        {
+            const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if (data != 0 && generationOf(data) == m_generation)
+                ++used;
+        }
+    }
+
+    const std::size_t sampled = buckets * BUCKET_SIZE;
+    return sampled > 0 ? static_cast<int>(used * 1000 / sampled) : 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Move.hpp"
+
+/**
+ * Таблица транспозиций: результаты поиска по ключу Zobrist позиции
+ * (Board::hash(), 104 клетки Omega-доски).
+ *
+ * Размер задаётся в мегабайтах и округляется вниз до степени двойки
+ * корзин. Корзина — ровно одна строка кэша (64 байта, 4 записи),
+ * так что проба читает одну строку.
+ *
+ * Таблица рассчитана на общий доступ из нескольких потоков поиска без
+ * мьютексов: запись — два 64-битных слова (key ^ data, data), и при
+ * чтении ключ восстанавливается через XOR. Если другой поток успел
+ * записать только одно из слов, ключ не сойдётся и запись просто
+ * будет пропущена.
+ */
+class TranspositionTable
+{
+public:
+    static constexpr std::size_t DEFAULT_MB = 16;
+
+    enum Bound : std::uint8_t
+    {
+        BoundNone  = 0,
+        BoundUpper = 1,   // оценка не выше score (ни один ход не поднял alpha)
+        BoundLower = 2,   // оценка не ниже score (отсечение по beta)
+        BoundExact = 3
+    };
+
+    struct Entry
+    {
+        PackedMove move;
+        int        score = 0;
+        int        depth = 0;
+        Bound      bound = BoundNone;
+    };
+
+    explicit TranspositionTable(std::size_t megabytes = DEFAULT_MB);
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    // Перевыделить таблицу (содержимое теряется); не во время поиска
+    void resize(std::size_t megabytes);
+
+    // Очистить (например, между партиями); не во время поиска
+    void clear() noexcept;
+
+    // Начало нового поиска: записи прошлых поисков вытесняются первыми
+    void newSearch() noexcept;
+
+    bool probe(std::uint64_t key, Entry &out) const noexcept;
+    void store(std::uint64_t key, PackedMove move, int score, int depth, Bound bound) noexcept;
+
+    // Заполненность записями текущего поиска, в промилле (по выборке)
+    int hashfull() const noexcept;
+
+    std::size_t sizeMb() const noexcept { return m_megabytes; }
+    std::size_t entryCount() const noexcept { return m_bucketCount * BUCKET_SIZE; }
+
+private:
+    static constexpr int BUCKET_SIZE = 4;
+
+    struct Slot
+    {
+        std::atomic<std::uint64_t> check{0};   // key ^ data
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    struct alignas(64) Bucket
+    {
+        Slot entries[BUCKET_SIZE];
+    };
+
+    static_assert(sizeof(Bucket) == 64, "корзина должна занимать одну строку кэша");
+
+    std::unique_ptr<Bucket[]> m_buckets;
+    std::size_t               m_bucketCount = 0;
+    std::size_t               m_megabytes   = 0;
+    std::uint8_t              m_generation  = 0;
+
+    Bucket &bucketFor(std::uint64_t key) const noexcept
+    {
+        return m_buckets[key & (m_bucketCount - 1)];
+    }
+};
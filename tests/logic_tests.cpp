@@ -1,11 +1,45 @@
 // tests/logic_tests.cpp
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "Board.hpp"   // Должен объявлять Board и Piece/ PieceColor / PieceKind
+#include "Attacks.hpp"
+#include "Fen.hpp"
+#include "GameFile.hpp"
+#include "GameReader.hpp"
+#include "MoveGen.hpp"
+#include "Notation.hpp"
+#include "OpeningBook.hpp"
+#include "PositionIndex.hpp"
+#include "Rules.hpp"
+#include "Evaluate.hpp"
+#include "MovePicker.hpp"
+#include "Nnue.hpp"
+#include "PawnTable.hpp"
+#include "Search.hpp"
+#include "See.hpp"
+#include "SmpSearch.hpp"
 // #include "GameController.hpp"   // Можно подключить позже, когда появится реализация
 
+[[noreturn]] static void checkFailed(const char *expr, const char *file, int line)
+{
+    std::cerr << file << ":" << line << ": проверка не прошла: " << expr << "\n";
+    std::abort();
+}
+
+// Проверка вызова с побочным действием (запись и загрузка файлов, разбор):
+// в отличие от assert выражение вычисляется и проверяется и в сборке с NDEBUG
+#define CHECK(expr) ((expr) ? static_cast<void>(0) : checkFailed(#expr, __FILE__, __LINE__))
+
 // Тест геометрии и валидности клеток Omega-доски
 void testBoardGeometry()
 {
@@ -104,6 +138,2094 @@ void testInitialPosition_skeleton()
     std::cout << "[OK] testInitialPosition_skeleton (минимальная проверка)\n";
 }
 
+// Тест компактной нумерации клеток: взаимно-однозначное соответствие
+// между валидными клетками массива 12x12 и индексами 0..103
+void testSquareIndexing()
+{
+    Board board;
+
+    int count = 0;
+    for (int r = 0; r < Board::ROWS; ++r)
+    {
+        for (int c = 0; c < Board::COLS; ++c)
+        {
+            const Square sq = Squares::fromCell(r, c);
+            assert((sq != NO_SQUARE) == board.isValidCell(r, c));
+            if (sq == NO_SQUARE)
+                continue;
+
+            assert(sq == count);
+            assert(Squares::rowOf(sq) == r);
+            assert(Squares::colOf(sq) == c);
+            ++count;
+        }
+    }
+    assert(count == SQUARE_COUNT);
+
+    assert(Squares::fromCell(0, 0)   == 0);
+    assert(Squares::fromCell(0, 11)  == 1);
+    assert(Squares::fromCell(1, 1)   == 2);
+    assert(Squares::fromCell(10, 10) == 101);
+    assert(Squares::fromCell(11, 11) == 103);
+    assert(Squares::fromCell(-1, 3)  == NO_SQUARE);
+
+    Bitboard bb;
+    assert(bb.empty());
+    bb.set(3);
+    bb.set(70);
+    bb.set(103);
+    assert(bb.popcount() == 3);
+    assert(bb.lsb() == 3 && bb.msb() == 103);
+    assert(bb.popLsb() == 3);
+    assert(bb.popLsb() == 70);
+    assert(bb.popLsb() == 103);
+    assert(bb.empty());
+    assert(Bitboard::all().popcount() == SQUARE_COUNT);
+    assert((~Bitboard()) == Bitboard::all());
+
+    std::cout << "[OK] testSquareIndexing\n";
+}
+
+// Проверка, что битборды доски согласованы с массивом клеток
+static void checkBitboardsMatchCells(const Board &board)
+{
+    Bitboard occupied;
+    Bitboard white;
+    Bitboard black;
+
+    for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+    {
+        const int r = Squares::rowOf(sq);
+        const int c = Squares::colOf(sq);
+        const Piece &p = board.pieceAt(r, c);
+
+        assert(&board.pieceAt(sq) == &p);
+        assert(board.occupied().test(sq) == !board.isEmpty(r, c));
+
+        if (p.isEmpty())
+            continue;
+
+        occupied.set(sq);
+        (p.color == PieceColor::White ? white : black).set(sq);
+        assert(board.pieces(p.kind).test(sq));
+        assert(board.pieces(p.color, p.kind).test(sq));
+    }
+
+    const PieceColor colors[] = {PieceColor::White, PieceColor::Black};
+    for (PieceColor color : colors)
+    {
+        for (int k = 1; k <= 8; ++k)
+        {
+            [[maybe_unused]] const PieceKind kind = static_cast<PieceKind>(k);
+            assert(board.pieceCount(color, kind) == board.pieces(color, kind).popcount());
+        }
+
+        [[maybe_unused]] const Bitboard kings = board.pieces(color, PieceKind::King);
+        assert(board.kingSquare(color) == (kings.any() ? kings.lsb() : NO_SQUARE));
+    }
+
+    assert(board.occupied() == occupied);
+    assert(board.pieces(PieceColor::White) == white);
+    assert(board.pieces(PieceColor::Black) == black);
+    assert((board.pieces(PieceColor::White) | board.pieces(PieceColor::Black)) == board.occupied());
+}
+
+// Тест эквивалентности битбордов и API массива клеток
+void testBitboardEquivalence()
+{
+    Board board;
+    board.resetToInitialPosition();
+    checkBitboardsMatchCells(board);
+
+    assert(board.occupied().popcount() == 44);
+    assert(board.pieces(PieceColor::White, PieceKind::Pawn).popcount() == 10);
+    assert(board.pieces(PieceColor::Black, PieceKind::Wizard).popcount() == 2);
+    assert(board.pieces(PieceColor::White, PieceKind::King).lsb() == Squares::fromCell(10, 6));
+    assert(board.kingSquare(PieceColor::White) == Squares::fromCell(10, 6));
+    assert(board.kingSquare(PieceColor::Black) == Squares::fromCell(1, 6));
+    assert(board.pieceCount(PieceColor::Black, PieceKind::Champion) == 2);
+
+    // Случайные установки/очистки клеток
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> cellDist(0, Board::ROWS - 1);
+    std::uniform_int_distribution<int> kindDist(0, 8);
+    std::uniform_int_distribution<int> colorDist(0, 2);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const int r = cellDist(rng);
+        const int c = cellDist(rng);
+
+        if (i % 3 == 0)
+        {
+            board.clearCell(r, c);
+        }
+        else
+        {
+            Piece p;
+            p.color = static_cast<PieceColor>(colorDist(rng));
+            p.kind  = static_cast<PieceKind>(kindDist(rng));
+            board.setPieceAt(r, c, p);
+        }
+
+        if (i % 50 == 0)
+            checkBitboardsMatchCells(board);
+    }
+    checkBitboardsMatchCells(board);
+
+    board.clear();
+    assert(board.occupied().empty());
+    checkBitboardsMatchCells(board);
+
+    std::cout << "[OK] testBitboardEquivalence\n";
+}
+
+// Эталон для генератора: перебор всех пар клеток через Rules
+// (ту же проверку хода выполняет GameController)
+static void bruteForceLegalMoves(const Board &board, MoveList &moves)
+{
+    for (Square from = 0; from < SQUARE_COUNT; ++from)
+    {
+        for (Square to = 0; to < SQUARE_COUNT; ++to)
+        {
+            Move mv;
+            mv.from = Position(Squares::rowOf(from), Squares::colOf(from));
+            mv.to   = Position(Squares::rowOf(to),   Squares::colOf(to));
+
+            PackedMove packed;
+            if (!Rules::decodeMove(board, mv, packed))
+                continue;
+
+            Board after = board;
+            after.makeMove(packed);
+            if (!Rules::isKingInCheck(after, board.sideToMove()))
+                moves.push(packed);
+        }
+    }
+}
+
+static void checkGeneratorMatchesRules(const Board &board)
+{
+    MoveList generated;
+    MoveList expected;
+    MoveGen::generateLegal(board, generated);
+    bruteForceLegalMoves(board, expected);
+
+    assert(generated.size() == expected.size());
+    for ([[maybe_unused]] PackedMove m : expected)
+        assert(generated.contains(m));
+}
+
+// Случайная позиция: короли + случайный набор фигур со случайными флагами hasMoved
+static void randomPosition(Board &board, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> sqDist(0, SQUARE_COUNT - 1);
+    std::uniform_int_distribution<int> kindDist(2, 8);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::uniform_int_distribution<int> countDist(4, 30);
+
+    board.clear();
+
+    const PieceColor colors[] = {PieceColor::White, PieceColor::Black};
+    for (PieceColor color : colors)
+    {
+        Square sq = sqDist(rng);
+        while (!board.pieceAt(sq).isEmpty())
+            sq = sqDist(rng);
+        board.setPieceAt(Squares::rowOf(sq), Squares::colOf(sq),
+                         Piece{color, PieceKind::King, coin(rng) == 1});
+    }
+
+    const int count = countDist(rng);
+    for (int i = 0; i < count; ++i)
+    {
+        const Square sq = sqDist(rng);
+        if (!board.pieceAt(sq).isEmpty())
+            continue;
+
+        Piece p{colors[coin(rng)], static_cast<PieceKind>(kindDist(rng)), coin(rng) == 1};
+        board.setPieceAt(Squares::rowOf(sq), Squares::colOf(sq), p);
+    }
+
+    board.setSideToMove(colors[coin(rng)]);
+}
+
+// Тест генератора ходов: совпадение с перебором через Rules
+void testMoveGenMatchesRules()
+{
+    Board board;
+    board.resetToInitialPosition();
+    checkGeneratorMatchesRules(board);
+
+    std::mt19937 rng(2024);
+
+    // Случайные партии из начальной позиции
+    for (int game = 0; game < 8; ++game)
+    {
+        board.resetToInitialPosition();
+        for (int ply = 0; ply < 80; ++ply)
+        {
+            checkGeneratorMatchesRules(board);
+
+            MoveList moves;
+            MoveGen::generateLegal(board, moves);
+            if (moves.empty())
+                break;
+
+            std::uniform_int_distribution<int> pick(0, moves.size() - 1);
+            board.makeMove(moves[pick(rng)]);
+        }
+    }
+
+    // Произвольные расстановки
+    for (int i = 0; i < 200; ++i)
+    {
+        randomPosition(board, rng);
+        checkGeneratorMatchesRules(board);
+    }
+
+    std::cout << "[OK] testMoveGenMatchesRules\n";
+}
+
+// Полное совпадение двух досок: клетки (включая hasMoved), битборды, сторона хода
+[[maybe_unused]] static bool sameBoards(const Board &a, const Board &b)
+{
+    for (int r = 0; r < Board::ROWS; ++r)
+    {
+        for (int c = 0; c < Board::COLS; ++c)
+        {
+            const Piece &pa = a.pieceAt(r, c);
+            const Piece &pb = b.pieceAt(r, c);
+            if (pa.color != pb.color || pa.kind != pb.kind || pa.hasMoved != pb.hasMoved)
+                return false;
+        }
+    }
+
+    return a.occupied() == b.occupied() &&
+           a.pieces(PieceColor::White) == b.pieces(PieceColor::White) &&
+           a.sideToMove() == b.sideToMove();
+}
+
+// Тест make/unmake: откат любого легального хода восстанавливает позицию
+void testMakeUnmake()
+{
+    std::mt19937 rng(99);
+    Board board;
+
+    for (int game = 0; game < 10; ++game)
+    {
+        board.resetToInitialPosition();
+        for (int ply = 0; ply < 120; ++ply)
+        {
+            MoveList moves;
+            MoveGen::generateLegal(board, moves);
+            if (moves.empty())
+                break;
+
+            for (PackedMove m : moves)
+            {
+                const Board before = board;
+                UndoInfo undo;
+                board.makeMove(m, undo);
+                checkBitboardsMatchCells(board);
+                board.unmakeMove(m, undo);
+                assert(sameBoards(board, before));
+            }
+
+            std::uniform_int_distribution<int> pick(0, moves.size() - 1);
+            board.makeMove(moves[pick(rng)]);
+        }
+    }
+
+    std::cout << "[OK] testMakeUnmake\n";
+}
+
+// Находит легальный ход по координатам (row,col) → (row,col)
+static PackedMove findMove(const Board &board, int fr, int fc, int tr, int tc)
+{
+    MoveList moves;
+    MoveGen::generateLegal(board, moves);
+    for (PackedMove m : moves)
+    {
+        if (m.from() == Squares::fromCell(fr, fc) && m.to() == Squares::fromCell(tr, tc))
+            return m;
+    }
+    assert(false && "ход не найден");
+    return PackedMove::none();
+}
+
+// Тест ключей Zobrist: инкрементальный ключ = посчитанному с нуля,
+// перестановки ходов дают тот же ключ, сторона хода и рокировка учитываются
+void testZobristHash()
+{
+    Board empty;
+    assert(empty.hash() == 0);
+
+    Board a;
+    a.resetToInitialPosition();
+    assert(a.hash() == a.computeHash());
+    assert(a.castlingRights() == (Board::WhiteKingSide | Board::WhiteQueenSide |
+                                  Board::BlackKingSide | Board::BlackQueenSide));
+
+    // Конь g и конь c в разном порядке
+    Board b = a;
+    a.makeMove(findMove(a, 10, 3, 8, 2));
+    a.makeMove(findMove(a, 1, 3, 3, 2));
+    a.makeMove(findMove(a, 10, 8, 8, 9));
+    b.makeMove(findMove(b, 10, 8, 8, 9));
+    b.makeMove(findMove(b, 1, 3, 3, 2));
+    b.makeMove(findMove(b, 10, 3, 8, 2));
+    assert(a.hash() == b.hash());
+    assert(a.hash() == a.computeHash());
+
+    // Сторона хода входит в ключ
+    Board c = a;
+    c.setSideToMove(PieceColor::White);
+    assert(c.hash() != a.hash());
+    assert(c.hash() == c.computeHash());
+
+    // Ход ладьёй туда и обратно: расстановка та же, но право на рокировку потеряно
+    Board d;
+    d.resetToInitialPosition();
+    [[maybe_unused]] const std::uint64_t initial = d.hash();
+    d.makeMove(findMove(d, 9, 9, 8, 9));   // пешка освобождает ладью
+    d.makeMove(findMove(d, 2, 1, 3, 1));
+    [[maybe_unused]] const std::uint64_t beforeRook = d.hash();
+    d.makeMove(findMove(d, 10, 9, 9, 9));
+    d.makeMove(findMove(d, 3, 1, 4, 1));
+    d.makeMove(findMove(d, 9, 9, 10, 9));
+    d.makeMove(findMove(d, 4, 1, 5, 1));
+    assert(!(d.castlingRights() & Board::WhiteKingSide));
+    assert(d.castlingRights() & Board::WhiteQueenSide);
+    assert(d.hash() == d.computeHash());
+    assert(d.hash() != beforeRook && d.hash() != initial);
+
+    // Случайные партии: инкрементальный ключ и откат
+    std::mt19937 rng(7);
+    for (int game = 0; game < 10; ++game)
+    {
+        Board board;
+        board.resetToInitialPosition();
+        for (int ply = 0; ply < 150; ++ply)
+        {
+            MoveList moves;
+            MoveGen::generateLegal(board, moves);
+            if (moves.empty())
+                break;
+
+            std::uniform_int_distribution<int> pick(0, moves.size() - 1);
+            const PackedMove m = moves[pick(rng)];
+            [[maybe_unused]] const std::uint64_t before = board.hash();
+
+            UndoInfo undo;
+            board.makeMove(m, undo);
+            assert(board.hash() == board.computeHash());
+            board.unmakeMove(m, undo);
+            assert(board.hash() == before);
+
+            board.makeMove(m);
+        }
+    }
+
+    std::cout << "[OK] testZobristHash\n";
+}
+
+// Тест таблиц атак прыгающих фигур: сравнение с шаблонами ходов
+// через разности координат
+void testLeaperTables()
+{
+    for (Square from = 0; from < SQUARE_COUNT; ++from)
+    {
+        for (Square to = 0; to < SQUARE_COUNT; ++to)
+        {
+            const int dr  = Squares::rowOf(to) - Squares::rowOf(from);
+            const int dc  = Squares::colOf(to) - Squares::colOf(from);
+            const int adr = std::abs(dr);
+            const int adc = std::abs(dc);
+
+            [[maybe_unused]] const bool knight   = (adr == 1 && adc == 2) || (adr == 2 && adc == 1);
+            [[maybe_unused]] const bool king     = (adr <= 1 && adc <= 1) && (adr + adc > 0);
+            [[maybe_unused]] const bool champion = (adr + adc == 1) ||
+                                                   (adr == 2 && adc == 0) || (adr == 0 && adc == 2) ||
+                                                   (adr == 2 && adc == 2);
+            [[maybe_unused]] const bool wizard   = (adr == 1 && adc == 1) ||
+                                                   (adr == 1 && adc == 3) || (adr == 3 && adc == 1);
+
+            assert(Attacks::KNIGHT[from].test(to)   == knight);
+            assert(Attacks::KING[from].test(to)     == king);
+            assert(Attacks::CHAMPION[from].test(to) == champion);
+            assert(Attacks::WIZARD[from].test(to)   == wizard);
+            assert(Attacks::WHITE_PAWN[from].test(to) == (dr == -1 && adc == 1));
+            assert(Attacks::BLACK_PAWN[from].test(to) == (dr == 1 && adc == 1));
+        }
+    }
+
+    // Угол волшебника (0,0): связан с полем только прыжками и диагональю
+    [[maybe_unused]] const Square corner = Squares::fromCell(0, 0);
+    assert(Attacks::WIZARD[corner].popcount() == 3);
+    assert(Attacks::WIZARD[corner].test(Squares::fromCell(1, 1)));
+    assert(Attacks::WIZARD[corner].test(Squares::fromCell(1, 3)));
+    assert(Attacks::WIZARD[corner].test(Squares::fromCell(3, 1)));
+    assert(Attacks::CHAMPION[corner].popcount() == 1);
+    assert(Attacks::KING[corner].popcount() == 1);
+    assert(Attacks::KNIGHT[corner].popcount() == 2);
+
+    // Король на поле рядом с углом видит угол
+    assert(Attacks::KING[Squares::fromCell(10, 10)].test(Squares::fromCell(11, 11)));
+
+    std::cout << "[OK] testLeaperTables\n";
+}
+
+// Атаки по лучу пошаговым обходом — эталон для Attacks::rook/bishop
+[[maybe_unused]] static Bitboard walkRays(Square from, const Bitboard &occupied, const int (*dirs)[2])
+{
+    Bitboard result;
+    for (int i = 0; i < 4; ++i)
+    {
+        int r = Squares::rowOf(from) + dirs[i][0];
+        int c = Squares::colOf(from) + dirs[i][1];
+        for (Square to = Squares::fromCell(r, c); to != NO_SQUARE; to = Squares::fromCell(r, c))
+        {
+            result.set(to);
+            if (occupied.test(to))
+                break;
+            r += dirs[i][0];
+            c += dirs[i][1];
+        }
+    }
+    return result;
+}
+
+// Тест лучевых атак скользящих фигур на случайных занятостях
+void testSliderAttacks()
+{
+    [[maybe_unused]] const int orthogonal[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+    [[maybe_unused]] const int diagonal[4][2]   = { {-1, -1}, {-1, 1}, {1, -1}, {1, 1} };
+
+    std::mt19937_64 rng(4242);
+    for (int i = 0; i < 2000; ++i)
+    {
+        // Разреженные и плотные занятости
+        Bitboard occupied(rng() & rng(), rng() & rng());
+        if (i % 2)
+            occupied = Bitboard(rng() | rng(), rng());
+        occupied &= Bitboard::all();
+
+        for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+        {
+            assert(Attacks::rook(sq, occupied)   == walkRays(sq, occupied, orthogonal));
+            assert(Attacks::bishop(sq, occupied) == walkRays(sq, occupied, diagonal));
+        }
+    }
+
+    // Из угла волшебника слон проходит всю длинную диагональ до противоположного угла
+    [[maybe_unused]] const Square corner = Squares::fromCell(11, 11);
+    assert(Attacks::bishop(corner, Bitboard()).popcount() == 11);
+    assert(Attacks::rook(corner, Bitboard()).empty());
+
+    std::cout << "[OK] testSliderAttacks\n";
+}
+
+// Тест attackersTo: совпадение с перебором всех фигур через pieceAttacksSquare
+void testAttackersTo()
+{
+    std::mt19937 rng(31337);
+    Board board;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        randomPosition(board, rng);
+
+        for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+        {
+            Bitboard expected;
+            Bitboard occ = board.occupied();
+            while (occ.any())
+            {
+                const Square from = occ.popLsb();
+                if (from != sq &&
+                    Rules::pieceAttacksSquare(board, board.pieceAt(from),
+                                              Squares::rowOf(from), Squares::colOf(from),
+                                              Squares::rowOf(sq), Squares::colOf(sq)))
+                {
+                    expected.set(from);
+                }
+            }
+            assert(Rules::attackersTo(board, sq) == expected);
+        }
+    }
+
+    // Рентген: снятая с occupancy ладья открывает ладью за ней
+    board.clear();
+    board.setPieceAt(5, 1, Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setPieceAt(5, 3, Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setPieceAt(5, 4, Piece{PieceColor::Black, PieceKind::Knight, true});
+    board.setPieceAt(2, 6, Piece{PieceColor::Black, PieceKind::Wizard, true});
+
+    const Square target = Squares::fromCell(5, 5);
+    [[maybe_unused]] const Bitboard direct = Rules::attackersTo(board, target);
+    assert(direct.popcount() == 1 && direct.test(Squares::fromCell(2, 6)));
+
+    Bitboard occ = board.occupied();
+    occ.reset(Squares::fromCell(5, 4));
+    assert(Rules::attackersTo(board, target, occ).test(Squares::fromCell(5, 3)));
+    assert(!Rules::attackersTo(board, target, occ).test(Squares::fromCell(5, 1)));
+    occ.reset(Squares::fromCell(5, 3));
+    assert(Rules::attackersTo(board, target, occ).test(Squares::fromCell(5, 1)));
+
+    std::cout << "[OK] testAttackersTo\n";
+}
+
+// Регрессия perft из начальной позиции
+void testPerftInitialPosition()
+{
+    Board board;
+    board.resetToInitialPosition();
+
+    assert(MoveGen::perft(board, 1) == 40);
+    assert(MoveGen::perft(board, 2) == 1600);
+    assert(MoveGen::perft(board, 3) == 67202);
+
+    std::cout << "[OK] testPerftInitialPosition\n";
+}
+
+// Поиск: мат в один ход, выигрыш незащищённой фигуры, легальный ход в начале
+void testSearch()
+{
+    Searcher searcher;
+    SearchLimits limits;
+    limits.depth = 3;
+
+    // Ладья держит 2-ю горизонталь, вторая даёт мат по 1-й
+    Board board;
+    board.clear();
+    board.setPieceAt(1, 5,  Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 5, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(2, 10, Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setPieceAt(5, 1,  Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setSideToMove(PieceColor::White);
+
+    searcher.prepare();
+    SearchResult r = searcher.search(board, limits);
+    assert(r.score == SCORE_MATE - 1);
+    assert(Squares::rowOf(r.bestMove.to()) == 1);
+    assert(!r.pv.empty() && r.pv[0] == r.bestMove);
+
+    // Ферзь забирает незащищённую ладью
+    board.clear();
+    board.setPieceAt(1, 5,  Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 5, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(6, 2,  Piece{PieceColor::White, PieceKind::Queen, true});
+    board.setPieceAt(6, 8,  Piece{PieceColor::Black, PieceKind::Rook, true});
+    board.setSideToMove(PieceColor::White);
+
+    searcher.prepare();
+    r = searcher.search(board, limits);
+    assert(r.bestMove == PackedMove(Squares::fromCell(6, 2), Squares::fromCell(6, 8)));
+    assert(r.score >= 400);
+
+    // Из начальной позиции — легальный ход и полностью просчитанная глубина
+    board.resetToInitialPosition();
+    searcher.prepare();
+    r = searcher.search(board, limits);
+
+    MoveList legal;
+    MoveGen::generateLegal(board, legal);
+    assert(legal.contains(r.bestMove));
+    assert(r.depth == 3);
+    assert(r.nodes > 0);
+    assert(r.cutoffs > 0 && r.firstMoveCutoffs <= r.cutoffs);
+
+    std::cout << "[OK] testSearch\n";
+}
+
+// Таблица транспозиций: запись/чтение, проверка ключа, вытеснение, очистка
+void testTranspositionTable()
+{
+    TranspositionTable tt(1);
+    assert(tt.entryCount() == 1024 * 1024 / 64 * 4);
+    assert(tt.hashfull() == 0);
+
+    const PackedMove move(Squares::fromCell(9, 1), Squares::fromCell(8, 1));
+    const std::uint64_t key = 0x123456789ABCDEF0ull;
+
+    TranspositionTable::Entry e;
+    CHECK(!tt.probe(key, e));
+
+    tt.store(key, move, -(SCORE_MATE - 5), 7, TranspositionTable::BoundLower);
+    CHECK(tt.probe(key, e));
+    assert(e.move == move);
+    assert(e.score == -(SCORE_MATE - 5));
+    assert(e.depth == 7);
+    assert(e.bound == TranspositionTable::BoundLower);
+
+    // Тот же индекс корзины, другой ключ — не находится
+    CHECK(!tt.probe(key ^ (std::uint64_t{1} << 63), e));
+
+    // Обновление без хода сохраняет прежний лучший ход
+    tt.store(key, PackedMove::none(), 12, 8, TranspositionTable::BoundUpper);
+    CHECK(tt.probe(key, e));
+    assert(e.move == move && e.score == 12 && e.bound == TranspositionTable::BoundUpper);
+
+    // Корзина из 4 записей: пятый ключ вытесняет самую мелкую
+    for (std::uint64_t i = 1; i <= 4; ++i)
+        tt.store(key + (i << 40), move, 0, static_cast<int>(i), TranspositionTable::BoundExact);
+    CHECK(tt.probe(key, e));
+    CHECK(!tt.probe(key + (std::uint64_t{1} << 40), e));
+
+    // Заполнение и очистка
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 200000; ++i)
+        tt.store(rng(), move, 0, 1, TranspositionTable::BoundExact);
+    assert(tt.hashfull() > 900);
+
+    tt.clear();
+    assert(tt.hashfull() == 0);
+    CHECK(!tt.probe(key, e));
+
+    // Поиск с общей таблицей даёт тот же результат, что и с собственной
+    Board board;
+    board.resetToInitialPosition();
+    SearchLimits limits;
+    limits.depth = 4;
+
+    Searcher own;
+    Searcher shared(tt);
+    own.prepare();
+    const SearchResult a = own.search(board, limits);
+    shared.prepare();
+    const SearchResult b = shared.search(board, limits);
+    assert(a.bestMove == b.bestMove && a.score == b.score);
+    assert(tt.hashfull() > 0);
+
+    std::cout << "[OK] testTranspositionTable\n";
+}
+
+// Поэтапная выдача ходов: тот же набор, что у генератора, в порядке этапов
+void testMovePicker()
+{
+    std::mt19937 rng(12);
+    HistoryTable history;
+
+    for (int game = 0; game < 20; ++game)
+    {
+        Board board;
+        board.resetToInitialPosition();
+
+        for (int ply = 0; ply < 60; ++ply)
+        {
+            MoveList pseudo;
+            MoveGen::generatePseudoLegal(board, pseudo);
+            if (pseudo.empty())
+                break;
+
+            // Хеш-ход — случайный свой ход; киллеры — случайные, в т.ч. невозможные
+            const PackedMove hashMove = pseudo[static_cast<int>(rng() % pseudo.size())];
+            const PackedMove killers[2] = {
+                pseudo[static_cast<int>(rng() % pseudo.size())],
+                PackedMove(static_cast<Square>(rng() % SQUARE_COUNT), static_cast<Square>(rng() % SQUARE_COUNT))
+            };
+            history.update(board.sideToMove(), pseudo[0], 100);
+
+            MovePicker picker(board, hashMove, killers, history);
+            MoveList picked;
+            bool seenQuiet = false;
+            for (PackedMove m = picker.next(); !m.isNone(); m = picker.next())
+            {
+                assert(!picked.contains(m));
+                picked.push(m);
+
+                // После хеш-хода выгодные взятия идут раньше тихих ходов,
+                // проигрывающие по SEE — после
+                const bool quiet = m.isCastling() || board.pieceAt(m.to()).isEmpty();
+                if (picked.size() > 1)
+                {
+                    if (!quiet)
+                        assert(See::atLeast(board, m, 0) != seenQuiet);
+                    seenQuiet = seenQuiet || quiet;
+                }
+            }
+
+            assert(picked.size() == pseudo.size());
+            assert(picked[0] == hashMove);
+            for ([[maybe_unused]] PackedMove m : pseudo)
+                assert(picked.contains(m));
+
+            // Поиск взятий выдаёт ровно взятия, не проигрывающие по SEE
+            MovePicker captures(board);
+            int count = 0;
+            for (PackedMove m = captures.next(); !m.isNone(); m = captures.next())
+            {
+                assert(!m.isCastling() && !board.pieceAt(m.to()).isEmpty());
+                ++count;
+            }
+            int expected = 0;
+            for (PackedMove m : pseudo)
+            {
+                expected += (!m.isCastling() && !board.pieceAt(m.to()).isEmpty() &&
+                             See::atLeast(board, m, 0)) ? 1 : 0;
+            }
+            assert(count == expected);
+
+            MoveList legal;
+            MoveGen::generateLegal(board, legal);
+            if (legal.empty())
+                break;
+            board.makeMove(legal[static_cast<int>(rng() % legal.size())]);
+        }
+    }
+
+    // История насыщается и не выходит за границы
+    history.clear();
+    for (int i = 0; i < 1000; ++i)
+        history.update(PieceColor::White, PackedMove(2, 3), 5000);
+    assert(history.get(PieceColor::White, PackedMove(2, 3)) <= HistoryTable::MAX_SCORE);
+    assert(history.get(PieceColor::White, PackedMove(2, 3)) > HistoryTable::MAX_SCORE / 2);
+    assert(history.get(PieceColor::Black, PackedMove(2, 3)) == 0);
+
+    std::cout << "[OK] testMovePicker\n";
+}
+
+// Инкрементальная PSQT-оценка совпадает с пересчётом и симметрична по цветам
+void testIncrementalEval()
+{
+    Board board;
+    board.resetToInitialPosition();
+    assert(board.psqt() == Psqt::Score());
+    assert(board.phase() == Psqt::PHASE_MAX);
+    assert(Eval::evaluate(board) == 0);
+
+    std::mt19937 rng(31);
+    for (int game = 0; game < 30; ++game)
+    {
+        board.resetToInitialPosition();
+        for (int ply = 0; ply < 100; ++ply)
+        {
+            MoveList legal;
+            MoveGen::generateLegal(board, legal);
+            if (legal.empty())
+                break;
+
+            const PackedMove m = legal[static_cast<int>(rng() % legal.size())];
+            [[maybe_unused]] const Psqt::Score before = board.psqt();
+            [[maybe_unused]] const int phaseBefore = board.phase();
+
+            UndoInfo undo;
+            board.makeMove(m, undo);
+            assert(board.psqt() == board.computePsqt());
+
+            int phase = 0;
+            Bitboard occ = board.occupied();
+            while (occ.any())
+                phase += Psqt::phaseWeight(board.pieceAt(occ.popLsb()).kind);
+            assert(board.phase() == phase);
+
+            board.unmakeMove(m, undo);
+            assert(board.psqt() == before && board.phase() == phaseBefore);
+            board.makeMove(m);
+
+            // Зеркальная позиция (цвета и горизонтали поменяны) — та же оценка
+            Board mirrored;
+            mirrored.clear();
+            Bitboard pieces = board.occupied();
+            while (pieces.any())
+            {
+                const Square sq = pieces.popLsb();
+                Piece p = board.pieceAt(sq);
+                p.color = (p.color == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+                mirrored.setPieceAt(Board::ROWS - 1 - Squares::rowOf(sq), Squares::colOf(sq), p);
+            }
+            mirrored.setSideToMove(board.sideToMove() == PieceColor::White ? PieceColor::Black
+                                                                          : PieceColor::White);
+            assert(Eval::evaluate(mirrored) == Eval::evaluate(board));
+        }
+    }
+
+    // Ручная правка доски тоже учитывается
+    board.clear();
+    board.setPieceAt(5, 5, Piece{PieceColor::White, PieceKind::Queen, true});
+    assert(board.psqt() == Psqt::TABLE[static_cast<int>(PieceKind::Queen)][Squares::fromCell(5, 5)]);
+    assert(board.phase() == Psqt::phaseWeight(PieceKind::Queen));
+    board.clearCell(5, 5);
+    assert(board.psqt() == Psqt::Score() && board.phase() == 0);
+
+    std::cout << "[OK] testIncrementalEval\n";
+}
+
+// Эталон SEE: размен на копии доски, каждый раз самой дешёвой фигурой
+static int seeReference(Board board, Square to, PieceColor side)
+{
+    // Короля не берут
+    if (board.pieceAt(to).kind == PieceKind::King)
+        return 0;
+
+    Bitboard attackers = Rules::attackersTo(board, to) & board.pieces(side);
+    Square from = NO_SQUARE;
+    int cheapest = 0;
+    while (attackers.any())
+    {
+        const Square sq = attackers.popLsb();
+        const PieceKind kind = board.pieceAt(sq).kind;
+        const int value = (kind == PieceKind::King) ? 100000 : Eval::pieceValue(kind);
+        if (from == NO_SQUARE || value < cheapest)
+        {
+            from = sq;
+            cheapest = value;
+        }
+    }
+    if (from == NO_SQUARE)
+        return 0;
+
+    const PieceColor enemy = (side == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+    if (board.pieceAt(from).kind == PieceKind::King &&
+        (Rules::attackersTo(board, to) & board.pieces(enemy)).any())
+    {
+        return 0;
+    }
+
+    const int victim = Eval::pieceValue(board.pieceAt(to).kind);
+    const Piece mover = board.pieceAt(from);
+    board.clearCell(Squares::rowOf(from), Squares::colOf(from));
+    board.setPieceAt(Squares::rowOf(to), Squares::colOf(to), mover);
+
+    return std::max(0, victim - seeReference(board, to, enemy));
+}
+
+// SEE: известные размены и сверка с эталоном на случайных позициях
+void testSee()
+{
+    Board board;
+    board.clear();
+    board.setPieceAt(1, 5,  Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 5, Piece{PieceColor::White, PieceKind::King, true});
+    board.setSideToMove(PieceColor::White);
+
+    // Ладья берёт пешку, защищённую пешкой: -400
+    board.setPieceAt(5, 8, Piece{PieceColor::Black, PieceKind::Pawn, true});
+    board.setPieceAt(4, 7, Piece{PieceColor::Black, PieceKind::Pawn, true});
+    board.setPieceAt(5, 2, Piece{PieceColor::White, PieceKind::Rook, true});
+    const PackedMove rxp(Squares::fromCell(5, 2), Squares::fromCell(5, 8));
+    assert(See::evaluate(board, rxp) == 100 - 500);
+    assert(!See::atLeast(board, rxp, 0));
+
+    // Рентген: ферзь за ладьёй поддерживает взятие
+    board.clearCell(4, 7);
+    board.setPieceAt(5, 8, Piece{PieceColor::Black, PieceKind::Knight, true});
+    board.setPieceAt(1, 8, Piece{PieceColor::Black, PieceKind::Rook, true});
+    assert(See::evaluate(board, rxp) == 300 - 500);
+    board.setPieceAt(5, 1, Piece{PieceColor::White, PieceKind::Queen, true});
+    assert(See::evaluate(board, rxp) == 300);
+
+    // Чемпион бьёт прыжком через занятую клетку, но ферзь за ним
+    // этой клеткой (своей пешкой) по-прежнему закрыт
+    board.clearCell(5, 2);
+    board.setPieceAt(5, 6, Piece{PieceColor::White, PieceKind::Champion, true});
+    board.setPieceAt(5, 7, Piece{PieceColor::White, PieceKind::Pawn, true});
+    const PackedMove cxn(Squares::fromCell(5, 6), Squares::fromCell(5, 8));
+    assert(See::evaluate(board, cxn) == 300 - 450);
+
+    // Тихий ход — 0
+    assert(See::evaluate(board, PackedMove(Squares::fromCell(10, 5), Squares::fromCell(10, 4))) == 0);
+
+    std::mt19937 rng(77);
+    for (int i = 0; i < 300; ++i)
+    {
+        randomPosition(board, rng);
+
+        MoveList pseudo;
+        MoveGen::generatePseudoLegal(board, pseudo);
+        for (PackedMove m : pseudo)
+        {
+            if (m.isCastling() || board.pieceAt(m.to()).isEmpty())
+                continue;
+
+            Board after = board;
+            const Piece mover = after.pieceAt(m.from());
+            [[maybe_unused]] const int victim = Eval::pieceValue(after.pieceAt(m.to()).kind);
+            after.clearCell(Squares::rowOf(m.from()), Squares::colOf(m.from()));
+            after.setPieceAt(Squares::rowOf(m.to()), Squares::colOf(m.to()), mover);
+
+            [[maybe_unused]] const PieceColor enemy = (mover.color == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+            assert(See::evaluate(board, m) == victim - seeReference(after, m.to(), enemy));
+        }
+    }
+
+    std::cout << "[OK] testSee\n";
+}
+
+// Lazy SMP: несколько потоков на общей таблице дают корректный результат
+void testParallelSearch()
+{
+    ParallelSearch search(3, 4);
+    assert(search.threadCount() == 3);
+
+    SearchLimits limits;
+    limits.depth = 3;
+
+    Board board;
+    board.clear();
+    board.setPieceAt(1, 5,  Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 5, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(2, 10, Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setPieceAt(5, 1,  Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setSideToMove(PieceColor::White);
+
+    search.prepare();
+    SearchResult r = search.search(board, limits);
+    assert(r.score == SCORE_MATE - 1);
+
+    board.resetToInitialPosition();
+    limits.depth = 4;
+    int iterations = 0;
+    search.prepare();
+    r = search.search(board, limits, [&](const SearchResult &) { ++iterations; });
+
+    MoveList legal;
+    MoveGen::generateLegal(board, legal);
+    assert(legal.contains(r.bestMove));
+    assert(r.depth == 4 && iterations == 4);
+
+    // Ограничение по узлам останавливает и вспомогательные потоки
+    limits.depth = 0;
+    limits.nodes = 20000;
+    search.prepare();
+    r = search.search(board, limits);
+    assert(legal.contains(r.bestMove));
+
+    search.setThreadCount(0);
+    assert(search.threadCount() == 1);
+
+    std::cout << "[OK] testParallelSearch\n";
+}
+
+// stop(), пришедший между prepare() и стартом потока поиска, не теряется:
+// так omega_uci отвечает на «go infinite» и сразу следом «stop»
+void testSearchStopBeforeStart()
+{
+    ParallelSearch search(2, 4);
+
+    Board board;
+    board.resetToInitialPosition();
+
+    for (int i = 0; i < 20; ++i)
+    {
+        search.prepare();
+        search.stop();
+
+        SearchResult r;
+        std::thread worker([&]() { r = search.search(board, SearchLimits()); });
+        worker.join();
+
+        MoveList legal;
+        MoveGen::generateLegal(board, legal);
+        assert(legal.contains(r.bestMove) && r.depth == 0);
+    }
+
+    // prepare() снова разрешает поиск
+    SearchLimits limits;
+    limits.depth = 3;
+    search.prepare();
+    const SearchResult r = search.search(board, limits);
+    assert(r.depth == 3);
+
+    std::cout << "[OK] testSearchStopBeforeStart\n";
+}
+
+// Сравнить аккумуляторы побайтно
+[[maybe_unused]] static bool sameAccumulator(const Nnue::Accumulator &a, const Nnue::Accumulator &b)
+{
+    return std::memcmp(a.values, b.values, sizeof(a.values)) == 0;
+}
+
+void testNnue()
+{
+    const char *path = "omega_test_network.nnue";
+
+    // Запись и загрузка через mmap
+    const Nnue::Network random = Nnue::Network::random(7);
+    assert(random.isLoaded());
+    CHECK(random.save(path));
+
+    Nnue::Network network;
+    assert(!network.isLoaded());
+    CHECK(network.load(path));
+    assert(std::memcmp(network.ftWeights(0), random.ftWeights(0),
+                       sizeof(std::int16_t) * Nnue::FEATURES * Nnue::HIDDEN) == 0);
+    assert(network.l2Bias() == random.l2Bias());
+
+    // Чужая версия и обрезанный файл отвергаются, загруженные веса остаются.
+    // Пишем в другой файл: отображённый трогать нельзя
+    const char *badPath = "omega_test_bad.nnue";
+    CHECK(random.save(badPath));
+    {
+        std::FILE *f = std::fopen(badPath, "r+b");
+        CHECK(f);
+        std::fseek(f, 8, SEEK_SET);
+        const unsigned char version[4] = {Nnue::FILE_VERSION + 1, 0, 0, 0};
+        std::fwrite(version, 1, sizeof(version), f);
+        std::fclose(f);
+    }
+    Nnue::Network rejected;
+    CHECK(!rejected.load(badPath) && !rejected.isLoaded());
+    {
+        std::FILE *f = std::fopen(badPath, "wb");
+        CHECK(f);
+        std::fwrite("OMEGANN", 1, 8, f);
+        std::fclose(f);
+    }
+    CHECK(!network.load(badPath) && network.isLoaded());
+    CHECK(!network.load("no_such_network.nnue"));
+    std::remove(badPath);
+
+    // Инкрементальные аккумуляторы = посчитанные с нуля, на всех наборах инструкций
+    std::vector<Nnue::Evaluator> evaluators;
+    for (Nnue::Isa isa : {Nnue::Isa::Scalar, Nnue::Isa::Sse41, Nnue::Isa::Avx2})
+    {
+        if (Nnue::isSupported(isa))
+            evaluators.emplace_back(network, isa);
+    }
+    assert(evaluators.front().isa() == Nnue::Isa::Scalar);
+
+    std::mt19937 rng(41);
+    Board board;
+    for (int game = 0; game < 20; ++game)
+    {
+        board.resetToInitialPosition();
+        for (Nnue::Evaluator &e : evaluators)
+            e.reset(board);
+
+        for (int ply = 0; ply < 100; ++ply)
+        {
+            MoveList legal;
+            MoveGen::generateLegal(board, legal);
+            if (legal.empty())
+                break;
+
+            // Ход туда и обратно: pop возвращает прежний аккумулятор
+            const PackedMove probe = legal[static_cast<int>(rng() % legal.size())];
+            [[maybe_unused]] const Nnue::Accumulator before = evaluators.front().current();
+            UndoInfo undo;
+            board.makeMove(probe, undo);
+            for (Nnue::Evaluator &e : evaluators)
+                e.push(board, probe, undo);
+            board.unmakeMove(probe, undo);
+            for (Nnue::Evaluator &e : evaluators)
+                e.pop();
+            assert(sameAccumulator(evaluators.front().current(), before));
+
+            const PackedMove m = legal[static_cast<int>(rng() % legal.size())];
+            board.makeMove(m, undo);
+
+            Nnue::Accumulator fresh;
+            evaluators.front().refresh(board, fresh);
+            [[maybe_unused]] const int expected = evaluators.front().evaluate(fresh, board.sideToMove());
+
+            for (Nnue::Evaluator &e : evaluators)
+            {
+                e.push(board, m, undo);
+                assert(sameAccumulator(e.current(), fresh));
+                assert(e.evaluate(board) == expected);
+            }
+
+            // Зеркальная позиция с другой стороной хода — та же оценка
+            Board mirrored;
+            mirrored.clear();
+            Bitboard pieces = board.occupied();
+            while (pieces.any())
+            {
+                const Square sq = pieces.popLsb();
+                Piece p = board.pieceAt(sq);
+                p.color = (p.color == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+                mirrored.setPieceAt(Board::ROWS - 1 - Squares::rowOf(sq), Squares::colOf(sq), p);
+            }
+            mirrored.setSideToMove(board.sideToMove() == PieceColor::White ? PieceColor::Black
+                                                                          : PieceColor::White);
+            Nnue::Accumulator mirroredAcc;
+            evaluators.front().refresh(mirrored, mirroredAcc);
+            assert(evaluators.front().evaluate(mirroredAcc, mirrored.sideToMove()) == expected);
+        }
+    }
+
+    // Поиск с оценкой сетью
+    Searcher searcher;
+    searcher.setNetwork(&network);
+
+    SearchLimits limits;
+    limits.depth = 3;
+    board.resetToInitialPosition();
+    searcher.prepare();
+    const SearchResult r = searcher.search(board, limits);
+
+    MoveList legal;
+    MoveGen::generateLegal(board, legal);
+    assert(legal.contains(r.bestMove) && r.depth == 3);
+
+    std::remove(path);
+
+    std::cout << "[OK] testNnue\n";
+}
+
+void testPawnTable()
+{
+    // Пешечный ключ ведётся инкрементально и не зависит от прочих фигур
+    Board board;
+    board.resetToInitialPosition();
+    assert(board.pawnHash() == board.computePawnHash() && board.pawnHash() != 0);
+
+    PawnTable table(1000);
+    std::mt19937 rng(53);
+    for (int game = 0; game < 20; ++game)
+    {
+        board.resetToInitialPosition();
+        for (int ply = 0; ply < 100; ++ply)
+        {
+            MoveList legal;
+            MoveGen::generateLegal(board, legal);
+            if (legal.empty())
+                break;
+
+            const PackedMove m = legal[static_cast<int>(rng() % legal.size())];
+            [[maybe_unused]] const std::uint64_t before = board.pawnHash();
+            [[maybe_unused]] const bool pawnsTouched = board.pieceAt(m.from()).kind == PieceKind::Pawn ||
+                                                       board.pieceAt(m.to()).kind == PieceKind::Pawn;
+
+            UndoInfo undo;
+            board.makeMove(m, undo);
+            assert(board.pawnHash() == board.computePawnHash());
+            assert((board.pawnHash() != before) == pawnsTouched);
+            board.unmakeMove(m, undo);
+            assert(board.pawnHash() == before);
+            board.makeMove(m);
+
+            // Из таблицы — то же, что разбор с нуля
+            [[maybe_unused]] const PawnEntry fresh = Pawns::analyze(board);
+            [[maybe_unused]] const PawnEntry &cached = table.probe(board);
+            assert(cached.key == fresh.key && cached.score == fresh.score);
+            assert(cached.passed[0] == fresh.passed[0] && cached.passed[1] == fresh.passed[1]);
+            assert(Eval::evaluate(board, table) == Eval::evaluate(board));
+        }
+    }
+    assert(table.probes() > 0 && table.hits() > 0 && table.hits() < table.probes());
+
+    // Повторный запрос той же структуры — попадание
+    table.resetStats();
+    table.probe(board);
+    table.probe(board);
+    assert(table.probes() == 2 && table.hits() >= 1);
+
+    // Разбор структуры: у белых сдвоенные изолированные на вертикали 1
+    // (передняя — проходная), связка 5–6; у чёрных одна пешка на 6
+    board.clear();
+    board.setPieceAt(10, 1, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(1, 10, Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(8, 1, Piece{PieceColor::White, PieceKind::Pawn, true});
+    board.setPieceAt(5, 1, Piece{PieceColor::White, PieceKind::Pawn, true});
+    board.setPieceAt(8, 5, Piece{PieceColor::White, PieceKind::Pawn, true});
+    board.setPieceAt(7, 6, Piece{PieceColor::White, PieceKind::Pawn, true});
+    board.setPieceAt(3, 6, Piece{PieceColor::Black, PieceKind::Pawn, true});
+
+    [[maybe_unused]] const PawnEntry entry = Pawns::analyze(board);
+    Bitboard whitePassed;
+    whitePassed.set(Squares::fromCell(5, 1));
+    assert(entry.passedPawns(PieceColor::White) == whitePassed);
+    assert(entry.passedPawns(PieceColor::Black).empty());
+    // Белые: 2 × изолированная, сдвоенная, защищённая, проходная на 4; чёрные: изолированная
+    assert(entry.score == Psqt::Score(-6 + 10, -4 + 14));
+    assert(Pawns::advancement(PieceColor::White, Squares::fromCell(5, 1)) == 4);
+    assert(Pawns::advancement(PieceColor::Black, Squares::fromCell(3, 6)) == 1);
+
+    // Зеркальная структура — оценка с обратным знаком
+    Board mirrored;
+    mirrored.clear();
+    Bitboard pieces = board.occupied();
+    while (pieces.any())
+    {
+        const Square sq = pieces.popLsb();
+        Piece p = board.pieceAt(sq);
+        p.color = (p.color == PieceColor::White) ? PieceColor::Black : PieceColor::White;
+        mirrored.setPieceAt(Board::ROWS - 1 - Squares::rowOf(sq), Squares::colOf(sq), p);
+    }
+    assert(Pawns::analyze(mirrored).score == -entry.score);
+
+    // Пешка, взявшая волшебника в углу, в структуре не участвует: ни
+    // изолированной, ни проходной, и соседние вертикали за краем не читаются
+    Board corner;
+    CHECK(Fen::parse("P1/10/10/10/10/4k5/10/10/10/10/4K5/2 w - 0", corner));
+    assert(corner.pieceAt(Squares::fromCell(0, 0)).kind == PieceKind::Pawn);
+    [[maybe_unused]] const PawnEntry cornerEntry = Pawns::analyze(corner);
+    assert(cornerEntry.score == Psqt::Score());
+    assert(cornerEntry.passedPawns(PieceColor::White).empty());
+    assert(Eval::evaluate(corner, table) == Eval::evaluate(corner));
+
+    // Без пешек — нулевой ключ и пустая запись
+    board.clear();
+    assert(board.pawnHash() == 0);
+    assert(Pawns::analyze(board).score == Psqt::Score());
+
+    std::cout << "[OK] testPawnTable\n";
+}
+
+// Мат и пат: hasLegalMove против полного перебора легальных ходов
+void testTerminalStates()
+{
+    Board board;
+    board.resetToInitialPosition();
+    assert(MoveGen::hasLegalMove(board));
+
+    // Мат по первой горизонтали: ладья (1,10) шахует, (2,9) держит вторую
+    board.clear();
+    board.setPieceAt(1, 5,  Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 5, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(1, 10, Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setPieceAt(2, 9,  Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setSideToMove(PieceColor::Black);
+    assert(Rules::isKingInCheck(board, PieceColor::Black));
+    assert(!MoveGen::hasLegalMove(board));
+
+    // Перекрыть линию может слон
+    board.setPieceAt(3, 5, Piece{PieceColor::Black, PieceKind::Bishop, true});
+    assert(MoveGen::hasLegalMove(board));
+
+    // Пат: король в углу волшебника, единственная клетка (1,1) под ладьёй
+    board.clear();
+    board.setPieceAt(0, 0,   Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 10, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(5, 1,   Piece{PieceColor::White, PieceKind::Rook, true});
+    board.setSideToMove(PieceColor::Black);
+    assert(!Rules::isKingInCheck(board, PieceColor::Black));
+    assert(!MoveGen::hasLegalMove(board));
+
+    // Случайные разреженные позиции: у атакующей стороны фигур больше,
+    // поэтому часто встречаются шахи, маты и паты
+    std::mt19937 rng(77);
+    std::uniform_int_distribution<int> sqDist(0, SQUARE_COUNT - 1);
+    std::uniform_int_distribution<int> kindDist(2, 8);
+    std::uniform_int_distribution<int> coin(0, 1);
+
+    int terminal = 0;
+    int evasions = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        board.clear();
+        const int counts[] = {0, 1 + static_cast<int>(rng() % 6), static_cast<int>(rng() % 3)};
+        const PieceColor colors[] = {PieceColor::White, PieceColor::Black};
+        for (PieceColor color : colors)
+        {
+            Square sq = sqDist(rng);
+            board.setPieceAt(Squares::rowOf(sq), Squares::colOf(sq), Piece{color, PieceKind::King, true});
+            for (int k = 0; k < counts[static_cast<int>(color)]; ++k)
+            {
+                sq = sqDist(rng);
+                if (board.pieceAt(sq).isEmpty())
+                {
+                    board.setPieceAt(Squares::rowOf(sq), Squares::colOf(sq),
+                                     Piece{color, static_cast<PieceKind>(kindDist(rng)), coin(rng) == 1});
+                }
+            }
+        }
+        board.setSideToMove(PieceColor::Black);
+
+        // Короля могли поставить поверх другого — такие позиции пропускаем
+        if (board.pieceCount(PieceColor::White, PieceKind::King) != 1 ||
+            board.pieceCount(PieceColor::Black, PieceKind::King) != 1)
+        {
+            continue;
+        }
+
+        MoveList legal;
+        MoveGen::generateLegal(board, legal);
+        assert(MoveGen::hasLegalMove(board) == !legal.empty());
+
+        if (legal.empty())
+            ++terminal;
+        else if (Rules::isKingInCheck(board, PieceColor::Black))
+            ++evasions;
+    }
+    assert(terminal > 0 && evasions > 0);
+
+    std::cout << "[OK] testTerminalStates\n";
+}
+
+// Генератор сразу легальных ходов (связки, уходы от шаха) против
+// псевдолегальных ходов, отфильтрованных make/unmake
+void testPinsAndEvasions()
+{
+    Board board;
+
+    // Связанный чемпион ходит только по линии к ладье и может взять её,
+    // но не перепрыгнуть
+    board.clear();
+    board.setPieceAt(5, 1,  Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(5, 3,  Piece{PieceColor::White, PieceKind::Champion, true});
+    board.setPieceAt(5, 4,  Piece{PieceColor::Black, PieceKind::Rook, true});
+    board.setPieceAt(1, 10, Piece{PieceColor::Black, PieceKind::King, true});
+    board.setSideToMove(PieceColor::White);
+
+    MoveList legal;
+    MoveGen::generateLegal(board, legal);
+    int championMoves = 0;
+    for (PackedMove m : legal)
+    {
+        if (m.from() == Squares::fromCell(5, 3))
+            ++championMoves;
+    }
+    assert(championMoves == 2);
+    assert(legal.contains(PackedMove(Squares::fromCell(5, 3), Squares::fromCell(5, 2))));
+    assert(legal.contains(PackedMove(Squares::fromCell(5, 3), Squares::fromCell(5, 4))));
+    checkGeneratorMatchesRules(board);
+
+    // Рокировка, после которой ушедшая ладья открывает линию на короля
+    board.clear();
+    board.setPieceAt(10, 6,  Piece{PieceColor::White, PieceKind::King, false});
+    board.setPieceAt(10, 9,  Piece{PieceColor::White, PieceKind::Rook, false});
+    board.setPieceAt(10, 10, Piece{PieceColor::Black, PieceKind::Rook, true});
+    board.setPieceAt(1, 1,   Piece{PieceColor::Black, PieceKind::King, true});
+    board.setSideToMove(PieceColor::White);
+
+    MoveList pseudo;
+    MoveGen::generatePseudoLegal(board, pseudo);
+    const PackedMove castle(Squares::fromCell(10, 6), Squares::fromCell(10, 8), PackedMove::Castling);
+    assert(pseudo.contains(castle));
+    legal.clear();
+    MoveGen::generateLegal(board, legal);
+    assert(!legal.contains(castle));
+    checkGeneratorMatchesRules(board);
+
+    // Случайные позиции и партии: то же множество, что фильтр make/unmake
+    std::mt19937 rng(88);
+    for (int i = 0; i < 5000; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            randomPosition(board, rng);
+        }
+        else
+        {
+            board.resetToInitialPosition();
+            for (int ply = static_cast<int>(rng() % 120); ply > 0; --ply)
+            {
+                MoveList moves;
+                MoveGen::generateLegal(board, moves);
+                if (moves.empty())
+                    break;
+                board.makeMove(moves[static_cast<int>(rng() % moves.size())]);
+            }
+        }
+
+        pseudo.clear();
+        MoveGen::generatePseudoLegal(board, pseudo);
+        Board scratch = board;
+        MoveList expected;
+        for (PackedMove m : pseudo)
+        {
+            if (MoveGen::isLegal(scratch, m))
+                expected.push(m);
+        }
+
+        legal.clear();
+        MoveGen::generateLegal(board, legal);
+        assert(legal.size() == expected.size());
+        for ([[maybe_unused]] PackedMove m : expected)
+            assert(legal.contains(m));
+        assert(MoveGen::hasLegalMove(board) == !legal.empty());
+    }
+
+    std::cout << "[OK] testPinsAndEvasions\n";
+}
+
+// Счётчик правила 50 ходов и ничьи повторением / по 50 ходам в поиске
+void testDrawDetection()
+{
+    Board board;
+    board.resetToInitialPosition();
+    assert(board.halfmoveClock() == 0);
+
+    // Ход коня — +1, ход пешки — сброс; откат восстанавливает счётчик
+    UndoInfo undo;
+    const PackedMove knight(Squares::fromCell(10, 3), Squares::fromCell(8, 4));
+    board.makeMove(knight, undo);
+    assert(board.halfmoveClock() == 1);
+    board.unmakeMove(knight, undo);
+    assert(board.halfmoveClock() == 0);
+
+    std::mt19937 rng(99);
+    for (int ply = 0; ply < 200; ++ply)
+    {
+        MoveList legal;
+        MoveGen::generateLegal(board, legal);
+        if (legal.empty())
+            break;
+
+        const PackedMove m = legal[static_cast<int>(rng() % legal.size())];
+        [[maybe_unused]] const int before = board.halfmoveClock();
+        [[maybe_unused]] const bool irreversible = board.pieceAt(m.from()).kind == PieceKind::Pawn ||
+                                                   (!m.isCastling() && !board.pieceAt(m.to()).isEmpty());
+        board.makeMove(m, undo);
+        assert(board.halfmoveClock() == (irreversible ? 0 : before + 1));
+        board.unmakeMove(m, undo);
+        assert(board.halfmoveClock() == before);
+        board.makeMove(m);
+    }
+
+    // Король против короля и ферзя
+    board.clear();
+    board.setPieceAt(1, 1,  Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(10, 10, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(6, 8,  Piece{PieceColor::White, PieceKind::Queen, true});
+    board.setSideToMove(PieceColor::Black);
+    board.setHalfmoveClock(10);
+
+    SearchLimits limits;
+    limits.depth = 3;
+
+    Searcher searcher;
+    searcher.prepare();
+    SearchResult r = searcher.search(board, limits);
+    assert(r.score < -500);
+
+    // Позиция после одного из ходов чёрных уже была в партии —
+    // повторение спасает их
+    MoveList legal;
+    MoveGen::generateLegal(board, legal);
+    PackedMove escape = PackedMove::none();
+    for (PackedMove m : legal)
+    {
+        if (board.pieceAt(m.to()).isEmpty())
+            escape = m;
+    }
+    assert(!escape.isNone());
+
+    Board child = board;
+    child.makeMove(escape);
+    searcher.setHistory({child.hash()});
+    searcher.tt().clear();
+    searcher.prepare();
+    r = searcher.search(board, limits);
+    assert(r.score == 0 && r.bestMove == escape);
+    searcher.setHistory({});
+
+    // До правила 50 ходов один полуход: любой тихий ход — ничья
+    board.setSideToMove(PieceColor::White);
+    board.setHalfmoveClock(99);
+    searcher.tt().clear();
+    searcher.prepare();
+    r = searcher.search(board, limits);
+    assert(r.score == 0);
+
+    board.setHalfmoveClock(0);
+    searcher.tt().clear();
+    searcher.prepare();
+    r = searcher.search(board, limits);
+    assert(r.score > 500);
+
+    // Мат сотым полуходом — мат, а не ничья по правилу 50 ходов
+    board.clear();
+    board.setPieceAt(1, 5, Piece{PieceColor::Black, PieceKind::King, true});
+    board.setPieceAt(3, 5, Piece{PieceColor::White, PieceKind::King, true});
+    board.setPieceAt(2, 9, Piece{PieceColor::White, PieceKind::Queen, true});
+    board.setSideToMove(PieceColor::White);
+    board.setHalfmoveClock(99);
+
+    Board mated = board;
+    mated.makeMove(PackedMove(Squares::fromCell(2, 9), Squares::fromCell(2, 5)));
+    assert(mated.halfmoveClock() == 100);
+    assert(Rules::isKingInCheck(mated, PieceColor::Black) && !MoveGen::hasLegalMove(mated));
+
+    searcher.tt().clear();
+    searcher.prepare();
+    r = searcher.search(board, limits);
+    assert(isMateScore(r.score) && r.score > 0);
+    mated = board;
+    mated.makeMove(r.bestMove);
+    assert(mated.halfmoveClock() == 100 && !MoveGen::hasLegalMove(mated));
+
+    std::cout << "[OK] testDrawDetection\n";
+}
+
+// Текстовая запись клеток и ходов: a0..j9 и углы w1..w4
+void testNotation()
+{
+    assert(Notation::squareName(Squares::fromCell(10, 1)) == "a0");
+    assert(Notation::squareName(Squares::fromCell(1, 10)) == "j9");
+    assert(Notation::squareName(Squares::fromCell(11, 0)) == "w1");
+    assert(Notation::squareName(Squares::fromCell(11, 11)) == "w2");
+    assert(Notation::squareName(Squares::fromCell(0, 11)) == "w3");
+    assert(Notation::squareName(Squares::fromCell(0, 0)) == "w4");
+    assert(Notation::squareName(NO_SQUARE).empty());
+
+    for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+        assert(Notation::parseSquare(Notation::squareName(sq)) == sq);
+
+    assert(Notation::parseSquare("k0") == NO_SQUARE);
+    assert(Notation::parseSquare("w5") == NO_SQUARE);
+    assert(Notation::parseSquare("a10") == NO_SQUARE);
+    assert(Notation::parseSquare("") == NO_SQUARE);
+
+    // Каждый легальный ход читается обратно из своей записи
+    Board board;
+    board.resetToInitialPosition();
+
+    MoveList legal;
+    MoveGen::generateLegal(board, legal);
+    for ([[maybe_unused]] PackedMove m : legal)
+        assert(Notation::parseMove(board, Notation::moveToString(m)) == m);
+
+    assert(Notation::moveToString(PackedMove::none()) == "0000");
+    assert(Notation::parseMove(board, "e1e5").isNone());   // пешка на 4 клетки
+    assert(Notation::parseMove(board, "e1e").isNone());
+    assert(Notation::parseMove(board, "x1e3").isNone());
+
+    // Рокировка — ход короля на две клетки; флаг берётся из генератора
+    board.clear();
+    board.setPieceAt(10, 6,  Piece{PieceColor::White, PieceKind::King, false});
+    board.setPieceAt(10, 10, Piece{PieceColor::White, PieceKind::Rook, false});
+    board.setPieceAt(1, 1,   Piece{PieceColor::Black, PieceKind::King, true});
+    board.setSideToMove(PieceColor::White);
+
+    [[maybe_unused]] const PackedMove castle = Notation::parseMove(board, "f0h0");
+    assert(castle.isCastling() && Notation::moveToString(castle) == "f0h0");
+
+    std::cout << "[OK] testNotation\n";
+}
+
+// Запись позиции в духе FEN: начальная позиция, круговой разбор/запись, ошибки
+void testFen()
+{
+    Board initial;
+    initial.resetToInitialPosition();
+    assert(Fen::toString(initial) == Fen::START);
+
+    Board board;
+    CHECK(Fen::parse(Fen::START, board));
+    assert(board.hash() == initial.hash());
+    assert(board.castlingRights() == initial.castlingRights());
+    for (Square sq = 0; sq < SQUARE_COUNT; ++sq)
+    {
+        [[maybe_unused]] const Piece &a = board.pieceAt(sq);
+        [[maybe_unused]] const Piece &b = initial.pieceAt(sq);
+        assert(a.color == b.color && a.kind == b.kind && a.hasMoved == b.hasMoved);
+    }
+
+    // Случайные партии: запись и разбор сохраняют всё, что влияет на игру
+    std::mt19937 rng(2024);
+    for (int game = 0; game < 20; ++game)
+    {
+        Board b;
+        b.resetToInitialPosition();
+        for (int ply = 0; ply < 120; ++ply)
+        {
+            MoveList legal;
+            MoveGen::generateLegal(b, legal);
+            if (legal.empty())
+                break;
+            b.makeMove(legal[static_cast<int>(rng() % legal.size())]);
+
+            char text[Fen::MAX_LENGTH];
+            const std::size_t n = Fen::write(b, text, sizeof(text));
+            assert(n > 0 && std::strlen(text) == n);
+
+            Board parsed;
+            CHECK(Fen::parse(std::string_view(text, n), parsed));
+            assert(parsed.hash() == b.hash());
+            assert(parsed.pawnHash() == b.pawnHash());
+            assert(parsed.castlingRights() == b.castlingRights());
+            assert(parsed.halfmoveClock() == b.halfmoveClock());
+            assert(parsed.psqt().mg == b.psqt().mg && parsed.phase() == b.phase());
+            assert(Fen::toString(parsed) == text);
+
+            MoveList a, c;
+            MoveGen::generateLegal(b, a);
+            MoveGen::generateLegal(parsed, c);
+            assert(a.size() == c.size());
+            for ([[maybe_unused]] PackedMove m : a)
+                assert(c.contains(m));
+        }
+    }
+
+    // Запись в короткий буфер не выполняется
+    char tiny[8];
+    CHECK(Fen::write(initial, tiny, sizeof(tiny)) == 0);
+
+    // Поле полуходов можно опустить; лишние пробелы допустимы
+    CHECK(Fen::parse("2/10/10/10/4k5/10/10/10/10/10/5K4/2 b -", board));
+    assert(board.sideToMove() == PieceColor::Black && board.halfmoveClock() == 0);
+    CHECK(Fen::parse("  2/10/10/10/4k5/10/10/10/10/10/5K4/2  w  -  37 ", board));
+    assert(board.halfmoveClock() == 37);
+
+    const char *bad[] = {
+        "",
+        "2/10/10/10/4k5/10/10/10/10/10/5K4/2",               // нет стороны хода
+        "2/10/10/10/4k5/10/10/10/10/10/5K4/2 x -",           // неверная сторона
+        "2/10/10/10/4k5/10/10/10/10/10/5K4 w -",             // 11 строк
+        "2/10/10/10/4k6/10/10/10/10/10/5K4/2 w -",           // 11 клеток в строке
+        "3/10/10/10/4k5/10/10/10/10/10/5K4/2 w -",           // 3 клетки в углу
+        "2/10/10/10/4x5/10/10/10/10/10/5K4/2 w -",           // неизвестная фигура
+        "2/10/10/10/4k5/10/10/10/10/10/5K4/2 w K",           // рокировка без ладьи
+        "2/10/10/10/4k5/10/10/10/10/10/5K4/2 w KK",          // повтор права
+        "2/10/10/10/4k5/10/10/10/10/10/5K4/2 w - 70000",     // счётчик не влезает
+        "2/10/10/10/4k5/10/10/10/10/10/5K4/2 w - 0 1",       // лишнее поле
+        "2/10/10/10/10/10/10/10/10/10/5K4/2 w -",            // нет чёрного короля
+        "2/10/10/10/4k5/10/10/10/10/10/5KK3/2 w -",          // два белых короля
+        "2/10/10/10/4k5/10/10/10/10/10/2QQ1K4/2 w -",        // два белых ферзя
+        "2/pppppppp2/10/10/4k5/10/10/10/10/ppp7/5K4/2 w -",  // 11 чёрных пешек
+        // Ферзи на всю доску: генератор ходов переполнил бы MoveList
+        "2/Q1Q1Q1Q1Q1/10/1Q1Q1Q1Q1Q/10/Q1Q1Q1Q1Q1/4k5/1Q1Q1Q1Q1Q/10/Q1Q1Q1Q1Q1/4K5/2 w - 0",
+    };
+    for (const char *text : bad)
+    {
+        CHECK(!Fen::parse(text, board));
+        assert(board.occupied().empty());
+    }
+
+    std::cout << "[OK] testFen\n";
+}
+
+// Потоковое чтение партий: разметка, ошибки, чтение маленькими кусками
+namespace
+{
+    class RecordingVisitor : public Db::GameVisitor
+    {
+    public:
+        void beginGame(const Board &start) override
+        {
+            ++begun;
+            lastHash = start.hash();
+        }
+
+        void move(const Board &before, PackedMove move) override
+        {
+            assert(before.hash() == lastHash);
+            Board after = before;
+            after.makeMove(move);
+            lastHash = after.hash();
+            checksum = checksum * 31 + before.hash() + move.raw();
+        }
+
+        void endGame(const Db::GameSummary &summary) override
+        {
+            summaries.push_back(summary);
+        }
+
+        int                           begun    = 0;
+        std::uint64_t                 lastHash = 0;
+        std::uint64_t                 checksum = 0;
+        std::vector<Db::GameSummary>  summaries;
+    };
+}
+
+void testGameReader()
+{
+    const std::string archive =
+        "[Event \"Первая\"]\n"
+        "[Result \"1-0\"]\n"
+        "\n"
+        "1. e1e3 e8e6 {комментарий\n"
+        "на две строки} 2. d0g3!? $1 (2. f1f3 (2... x) d8d7) d8d7 ; до конца строки\n"
+        "3.f1f2 3... f8f7 1-0\n"
+        "\n"
+        "% служебная строка\n"
+        "[Event \"С позиции\"]\n"
+        "[FEN \"2/10/10/10/4k5/10/10/10/10/10/5K4/2 w - 0\"]\n"
+        "\n"
+        "1. f0f1 e6e5\n"
+        "[Event \"Нелегальный ход\"]\n"
+        "[Result \"0-1\"]\n"
+        "1. e1e3 e1e3 2. d0g3 0-1\n"
+        "\n"
+        "1. e1e3 *\n";
+
+    RecordingVisitor direct;
+    Db::GameReader reader(direct);
+    reader.readText(archive);
+
+    [[maybe_unused]] const Db::ReaderStats &s = reader.stats();
+    assert(s.games == 4 && s.invalidGames == 1);
+    assert(s.moves == 6 + 2 + 1 + 1);
+    assert(s.bytes == archive.size());
+
+    assert(direct.begun == 4 && direct.summaries.size() == 4);
+    assert(direct.summaries[0].result == Db::GameResult::WhiteWin && direct.summaries[0].plies == 6);
+    assert(direct.summaries[1].result == Db::GameResult::Unknown && direct.summaries[1].plies == 2);
+    assert(!direct.summaries[2].valid && direct.summaries[2].plies == 1);
+    assert(direct.summaries[2].result == Db::GameResult::BlackWin);
+    assert(direct.summaries[3].valid && direct.summaries[3].plies == 1);
+
+    // Тот же архив несколько раз, из файла через крошечный буфер:
+    // строки и лексемы режутся на границах кусков
+    const char *path = "omega_test_games.pgn";
+    std::FILE *f = std::fopen(path, "wb");
+    CHECK(f);
+    for (int i = 0; i < 5; ++i)
+        std::fwrite(archive.data(), 1, archive.size(), f);
+    std::fclose(f);
+
+    RecordingVisitor repeated;
+    Db::GameReader small(repeated, 64);
+    CHECK(small.readFile(path));
+    assert(small.stats().games == 20 && small.stats().invalidGames == 5);
+    assert(small.stats().moves == 5 * s.moves);
+    assert(small.stats().bytes == 5 * archive.size());
+    std::remove(path);
+
+    RecordingVisitor inMemory;
+    Db::GameReader whole(inMemory);
+    whole.readText(archive + archive + archive + archive + archive);
+    assert(inMemory.checksum == repeated.checksum);
+    assert(inMemory.summaries.size() == repeated.summaries.size());
+
+    CHECK(!small.readFile("omega_no_such_file.pgn"));
+
+    std::cout << "[OK] testGameReader\n";
+}
+
+void testGameFile()
+{
+    const char *binaryPath = "omega_test_games.ogb";
+    const char *textPath   = "omega_test_games.txt";
+
+    // Случайные партии из начальной позиции, одна — с позиции Fen, одна — без ходов
+    std::mt19937 rng(7);
+    std::vector<std::vector<PackedMove>> played;
+    Board start;
+    start.resetToInitialPosition();
+
+    Db::GameFileWriter writer;
+    CHECK(writer.open(binaryPath));
+    for (int g = 0; g < 6; ++g)
+    {
+        Board board = start;
+        std::vector<PackedMove> moves;
+        for (int ply = 0; ply < 40 + 10 * g; ++ply)
+        {
+            MoveList legal;
+            MoveGen::generateLegal(board, legal);
+            if (legal.empty())
+                break;
+            moves.push_back(legal[static_cast<int>(rng() % legal.size())]);
+            board.makeMove(moves.back());
+        }
+        CHECK(writer.addGame(start, moves.data(), static_cast<int>(moves.size()), Db::GameResult::Draw));
+        played.push_back(moves);
+    }
+
+    Board kings;
+    CHECK(Fen::parse("2/10/10/10/4k5/10/10/10/10/10/5K4/2 b - 0", kings));
+    const PackedMove kingMoves[2] = {Notation::parseMove(kings, "e6e5"), PackedMove()};
+    assert(!kingMoves[0].isNone());
+    CHECK(writer.addGame(kings, kingMoves, 1, Db::GameResult::BlackWin));
+    CHECK(writer.addGame(start, nullptr, 0, Db::GameResult::Unknown));
+    assert(writer.gameCount() == 8);
+    CHECK(writer.close());
+
+    // Чтение в обратном порядке: каждая партия находится по индексу
+    Db::GameFile games;
+    CHECK(games.open(binaryPath));
+    assert(games.gameCount() == 8);
+    for (int g = 7; g >= 0; --g)
+    {
+        Db::GameView game;
+        CHECK(games.game(static_cast<std::uint64_t>(g), game));
+        if (g < 6)
+        {
+            assert(game.result == Db::GameResult::Draw && game.fen.empty());
+            assert(game.plies == static_cast<int>(played[g].size()));
+            for (int i = 0; i < game.plies; ++i)
+                assert(game.move(i) == played[g][i]);
+        }
+        else if (g == 6)
+        {
+            assert(game.result == Db::GameResult::BlackWin && game.plies == 1);
+            assert(game.fen == Fen::toString(kings));
+            Board board;
+            CHECK(game.startPosition(board) && board.hash() == kings.hash());
+        }
+        else
+        {
+            assert(game.result == Db::GameResult::Unknown && game.plies == 0);
+        }
+    }
+    Db::GameView outside;
+    CHECK(!games.game(8, outside));
+
+    // Проигрывание даёт те же позиции и ходы, что текстовый архив после
+    // обратного преобразования
+    RecordingVisitor fromBinary;
+    for (std::uint64_t g = 0; g < games.gameCount(); ++g)
+    {
+        Db::GameView game;
+        CHECK(games.game(g, game) && game.replay(fromBinary));
+    }
+    games.close();
+
+    CHECK(Db::binaryToText(binaryPath, textPath));
+    RecordingVisitor fromText;
+    Db::GameReader reader(fromText);
+    CHECK(reader.readFile(textPath));
+    assert(reader.stats().games == 8 && reader.stats().invalidGames == 0);
+    assert(fromText.checksum == fromBinary.checksum);
+    assert(fromText.summaries.size() == fromBinary.summaries.size());
+    for (std::size_t i = 0; i < fromText.summaries.size(); ++i)
+    {
+        assert(fromText.summaries[i].result == fromBinary.summaries[i].result);
+        assert(fromText.summaries[i].plies == fromBinary.summaries[i].plies);
+    }
+
+    // Текст → бинарный → текст → бинарный: файлы совпадают байт в байт
+    const char *againPath = "omega_test_games2.ogb";
+    Db::ReaderStats stats;
+    CHECK(Db::textToBinary(textPath, againPath, &stats));
+    assert(stats.games == 8);
+    auto readAll = [](const char *path)
+    {
+        std::vector<char> bytes;
+        std::FILE *f = std::fopen(path, "rb");
+        if (!f)
+            return bytes;
+        for (int c; (c = std::fgetc(f)) != EOF; )
+            bytes.push_back(static_cast<char>(c));
+        std::fclose(f);
+        return bytes;
+    };
+    const std::vector<char> original = readAll(binaryPath);
+    CHECK(!original.empty());
+    assert(readAll(againPath) == original);
+
+    // Чужой или обрезанный файл не открывается
+    std::FILE *f = std::fopen(againPath, "wb");
+    CHECK(f);
+    std::fwrite(original.data(), 1, original.size() - 8, f);
+    std::fclose(f);
+    CHECK(!games.open(againPath));
+
+    f = std::fopen(againPath, "wb");
+    CHECK(f);
+    std::fwrite("OMEGAGX", 1, 8, f);
+    std::fwrite(original.data() + 8, 1, original.size() - 8, f);
+    std::fclose(f);
+    CHECK(!games.open(againPath));
+    CHECK(!games.open("omega_no_such_file.ogb"));
+
+    std::remove(binaryPath);
+    std::remove(textPath);
+    std::remove(againPath);
+
+    std::cout << "[OK] testGameFile\n";
+}
+
+void testPositionIndex()
+{
+    // Три партии с общим началом e1e3 e8e6: две продолжаются d0g3, одна f1f3
+    const std::string archive =
+        "[Result \"1-0\"]\n1. e1e3 e8e6 2. d0g3 d8d7 1-0\n\n"
+        "[Result \"1/2-1/2\"]\n1. e1e3 e8e6 2. d0g3 1/2-1/2\n\n"
+        "[Result \"0-1\"]\n1. e1e3 e8e6 2. f1f3 0-1\n\n"
+        "[Result \"1-0\"]\n1. e1e3 e1e3 1-0\n\n"
+        "1. d1d3 *\n";
+
+    Db::PositionIndexBuilder builder(3);
+    Db::GameReader reader(builder);
+    reader.readText(archive);
+    assert(builder.gameCount() == 4);   // партия с ошибкой не учитывается
+
+    const char *path = "omega_test_positions.opi";
+    CHECK(builder.write(path));
+
+    Db::PositionIndex index;
+    CHECK(index.open(path));
+    assert(index.gameCount() == 4);
+    // Начало: e1e3, d1d3; после e1e3: e8e6; после e8e6: d0g3, f1f3 (d8d7 — за пределом 3 полуходов)
+    assert(index.entryCount() == 5);
+
+    Board board;
+    board.resetToInitialPosition();
+    std::vector<Db::MoveStats> moves = index.moves(board);
+    assert(moves.size() == 2);
+    assert(Notation::moveToString(moves[0].move) == "e1e3" && moves[0].games == 3);
+    assert(moves[0].whiteWins == 1 && moves[0].blackWins == 1 && moves[0].draws == 1);
+    assert(Notation::moveToString(moves[1].move) == "d1d3" && moves[1].games == 1);
+    assert(moves[1].whiteWins + moves[1].blackWins + moves[1].draws == 0);
+
+    board.makeMove(Notation::parseMove(board, "e1e3"));
+    board.makeMove(Notation::parseMove(board, "e8e6"));
+    moves = index.moves(board);
+    assert(moves.size() == 2);
+    assert(Notation::moveToString(moves[0].move) == "d0g3" && moves[0].games == 2);
+    assert(moves[0].whiteWins == 1 && moves[0].draws == 1);
+    assert(Notation::moveToString(moves[1].move) == "f1f3" && moves[1].blackWins == 1);
+
+    // Позиция из Fen — тот же ключ; в маленький буфер пишется только часть
+    Board same;
+    CHECK(Fen::parse(Fen::toString(board), same));
+    Db::MoveStats one[1];
+    CHECK(index.find(same.hash(), one, 1) == 2);
+
+    board.makeMove(Notation::parseMove(board, "d0g3"));
+    assert(index.moves(board).empty());
+    CHECK(index.find(0, one, 1) == 0);
+
+    // Повтор позиции с тем же ходом в одной партии — одна партия, а не две
+    Db::PositionIndexBuilder repeated;
+    Db::GameReader repeatedReader(repeated);
+    repeatedReader.readText("1. c0d2 c9d7 2. d2c0 d7c9 3. c0d2 1-0\n");
+    CHECK(repeated.write(path));
+    CHECK(index.open(path));
+    Board initial;
+    initial.resetToInitialPosition();
+    moves = index.moves(initial);
+    assert(moves.size() == 1 && moves[0].games == 1 && moves[0].whiteWins == 1);
+
+    // Много партий — таблица из многих корзин
+    Db::PositionIndexBuilder many;
+    std::mt19937 rng(11);
+    for (int g = 0; g < 3000; ++g)
+    {
+        Board b;
+        b.resetToInitialPosition();
+        many.beginGame(b);
+        for (int ply = 0; ply < 30; ++ply)
+        {
+            MoveList legal;
+            MoveGen::generateLegal(b, legal);
+            if (legal.empty())
+                break;
+            const PackedMove m = legal[static_cast<int>(rng() % legal.size())];
+            many.move(b, m);
+            b.makeMove(m);
+        }
+        Db::GameSummary summary;
+        summary.result = Db::GameResult::Draw;
+        many.endGame(summary);
+    }
+    CHECK(many.write(path));
+    CHECK(index.open(path));
+    assert(index.gameCount() == 3000 && index.entryCount() > 1000);
+
+    Board start;
+    start.resetToInitialPosition();
+    std::uint32_t total = 0;
+    for (const Db::MoveStats &m : index.moves(start))
+    {
+        assert(m.draws == m.games);
+        total += m.games;
+    }
+    assert(total == 3000);
+
+    // Испорченный файл не открывается
+    std::FILE *f = std::fopen(path, "rb");
+    CHECK(f);
+    std::fseek(f, 0, SEEK_END);
+    std::vector<char> bytes(static_cast<std::size_t>(std::ftell(f)));
+    std::fseek(f, 0, SEEK_SET);
+    CHECK(std::fread(bytes.data(), 1, bytes.size(), f) == bytes.size());
+    std::fclose(f);
+    f = std::fopen(path, "wb");
+    CHECK(f);
+    std::fwrite(bytes.data(), 1, bytes.size() - 1, f);
+    std::fclose(f);
+    CHECK(!index.open(path));
+    assert(index.moves(start).empty());
+    std::remove(path);
+
+    std::cout << "[OK] testPositionIndex\n";
+}
+
+void testOpeningBook()
+{
+    // Очки стороны хода: победа 2, ничья 1, поражение 0
+    const std::string archive =
+        "1. e1e3 e8e6 2. d0g3 1-0\n\n"
+        "1. e1e3 e8e6 2. d0g3 1-0\n\n"
+        "1. e1e3 e8e6 2. f1f3 0-1\n\n"
+        "1. d1d3 1/2-1/2\n\n"
+        "1. d1d3 0-1\n\n"
+        "1. f1f3 0-1\n\n"
+        "1. f1f3 0-1\n";
+
+    Db::OpeningBookBuilder builder(4, 2);
+    Db::GameReader reader(builder);
+    reader.readText(archive);
+    assert(builder.gameCount() == 7);
+
+    const char *path = "omega_test_book.obk";
+    CHECK(builder.write(path));
+
+    Db::OpeningBook book;
+    CHECK(book.open(path));
+    // Начало: e1e3 (4 очка), d1d3 (1); f1f3 без очков, f1f3 после e8e6 — одна партия
+    assert(book.entryCount() == 4);
+
+    Board board;
+    board.resetToInitialPosition();
+    std::vector<Db::BookEntry> entries = book.entries(board);
+    assert(entries.size() == 2);
+    assert(Notation::moveToString(entries[0].move) == "e1e3" && entries[0].weight == 4 && entries[0].games == 3);
+    assert(Notation::moveToString(entries[1].move) == "d1d3" && entries[1].weight == 1 && entries[1].games == 2);
+
+    // Выбор по весу: 0..3 — e1e3, 4 — d1d3
+    assert(book.pick(board, 0) == entries[0].move);
+    assert(book.pick(board, 3) == entries[0].move);
+    assert(book.pick(board, 4) == entries[1].move);
+    assert(book.pick(board, 9) == entries[1].move);
+
+    board.makeMove(entries[0].move);
+    entries = book.entries(board);
+    assert(entries.size() == 1 && Notation::moveToString(entries[0].move) == "e8e6" && entries[0].weight == 2);
+
+    board.makeMove(entries[0].move);
+    entries = book.entries(board);
+    assert(entries.size() == 1 && Notation::moveToString(entries[0].move) == "d0g3" && entries[0].weight == 4);
+
+    board.makeMove(entries[0].move);
+    assert(book.entries(board).empty() && book.pick(board, 0).isNone());
+
+    // Запись с ключом позиции, но невозможным ходом находится, но не выдаётся
+    Board start;
+    start.resetToInitialPosition();
+    std::vector<std::uint8_t> bytes(32, 0);
+    std::memcpy(bytes.data(), "OMEGABK", 8);
+    bytes[8] = static_cast<std::uint8_t>(Db::OPENING_BOOK_VERSION);
+    for (int i = 0; i < 8; ++i)
+        bytes[16 + i] = static_cast<std::uint8_t>(start.hash() >> (8 * i));
+    const PackedMove blocked(Notation::parseSquare("a0"), Notation::parseSquare("a5"));
+    bytes[24] = static_cast<std::uint8_t>(blocked.raw());
+    bytes[25] = static_cast<std::uint8_t>(blocked.raw() >> 8);
+    bytes[26] = 10;
+    bytes[28] = 1;
+
+    std::FILE *f = std::fopen(path, "wb");
+    CHECK(f);
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+    CHECK(book.open(path) && book.entryCount() == 1);
+    Db::BookEntry one[1];
+    CHECK(book.find(start.hash(), one, 1) == 1 && one[0].move == blocked && one[0].weight == 10);
+    assert(book.entries(start).empty() && book.pick(start, 0).isNone());
+
+    // Размер не кратен записи или чужой заголовок — не открывается
+    f = std::fopen(path, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size() - 1, f);
+    std::fclose(f);
+    CHECK(!book.open(path) && !book.isOpen());
+    bytes[0] = 'X';
+    f = std::fopen(path, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+    CHECK(!book.open(path));
+    CHECK(book.find(start.hash(), one, 1) == 0);
+
+    // Пара (позиция, ход), повторённая в одной партии, — одна партия:
+    // в одиночку она не проходит отбор по minGames
+    Db::OpeningBookBuilder repeats(8, 2);
+    Db::GameReader repeatsReader(repeats);
+    repeatsReader.readText("1. c0d2 c9d7 2. d2c0 d7c9 3. c0d2 c9d7 *\n");
+    assert(repeats.gameCount() == 1);
+    CHECK(repeats.write(path));
+    CHECK(book.open(path) && book.entryCount() == 0);
+    std::remove(path);
+
+    std::cout << "[OK] testOpeningBook\n";
+}
+
 int main()
 {
     std::cout << "Запуск логических тестов Omega Chess...\n";
@@ -111,6 +2233,33 @@ int main()
     testBoardGeometry();
     testBoardCells();
     testInitialPosition_skeleton();
+    testSquareIndexing();
+    testBitboardEquivalence();
+    testMoveGenMatchesRules();
+    testLeaperTables();
+    testSliderAttacks();
+    testAttackersTo();
+    testMakeUnmake();
+    testZobristHash();
+    testPerftInitialPosition();
+    testSearch();
+    testTranspositionTable();
+    testParallelSearch();
+    testSearchStopBeforeStart();
+    testMovePicker();
+    testSee();
+    testIncrementalEval();
+    testNnue();
+    testPawnTable();
+    testTerminalStates();
+    testPinsAndEvasions();
+    testDrawDetection();
+    testNotation();
+    testFen();
+    testGameReader();
+    testGameFile();
+    testPositionIndex();
+    testOpeningBook();
 
     std::cout << "Все логические тесты успешно пройдены.\n";
     return 0;
@@ -0,0 +1,32 @@
+# tests/uci_clock.cmake
+#
+# Запуск: cmake -DUCI=<путь к omega_uci> -P uci_clock.cmake
+#
+# go с часами (wtime/btime) и без stop: omega_uci должен сам уложиться
+# во время и ответить bestmove. Ввод кончается без quit, поэтому движок
+# ждёт конца поиска — без бюджета времени запуск упёрся бы в TIMEOUT.
+
+if (NOT UCI)
+    message(FATAL_ERROR "не задан UCI")
+endif()
+
+set(input "${CMAKE_CURRENT_BINARY_DIR}/uci_clock_input.txt")
+foreach(go "go wtime 3000 btime 3000 winc 100 binc 100"
+           "go btime 3000 wtime 1 movestogo 1")
+    file(WRITE "${input}" "uci\nposition startpos moves e1e3\n${go}\n")
+    execute_process(
+            COMMAND "${UCI}"
+            INPUT_FILE "${input}"
+            OUTPUT_VARIABLE output
+            RESULT_VARIABLE result
+            TIMEOUT 20
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "«${go}»: omega_uci завершился с «${result}»")
+    endif()
+    if (NOT output MATCHES "bestmove [a-jw]")
+        message(FATAL_ERROR "«${go}»: нет bestmove:\n${output}")
+    endif()
+endforeach()
+
+file(REMOVE "${input}")
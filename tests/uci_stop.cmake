@@ -0,0 +1,31 @@
+# tests/uci_stop.cmake
+#
+# Запуск: cmake -DUCI=<путь к omega_uci> -P uci_stop.cmake
+#
+# Много раз подряд подаёт omega_uci «go infinite» и сразу следом «stop».
+# Каждый запуск должен ответить bestmove и readyok и завершиться по quit.
+
+if (NOT UCI)
+    message(FATAL_ERROR "не задан UCI")
+endif()
+
+set(input "${CMAKE_CURRENT_BINARY_DIR}/uci_stop_input.txt")
+file(WRITE "${input}" "uci\ngo infinite\nstop\nisready\nquit\n")
+
+foreach(run RANGE 1 50)
+    execute_process(
+            COMMAND "${UCI}"
+            INPUT_FILE "${input}"
+            OUTPUT_VARIABLE output
+            RESULT_VARIABLE result
+            TIMEOUT 10
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "запуск ${run}: omega_uci завершился с «${result}»")
+    endif()
+    if (NOT output MATCHES "bestmove" OR NOT output MATCHES "readyok")
+        message(FATAL_ERROR "запуск ${run}: нет bestmove или readyok:\n${output}")
+    endif()
+endforeach()
+
+file(REMOVE "${input}")
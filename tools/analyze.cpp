@@ -0,0 +1,86 @@
+// tools/analyze.cpp
+//
+// Анализ начальной позиции движком (search/) без GUI: после каждой
+// итерации печатает глубину, оценку, число узлов, скорость и главный вариант.
+//
+//   omega_analyze [глубина] [время_мс] [хеш_МБ]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Board.hpp"
+#include "Search.hpp"
+
+static void printMove(PackedMove m)
+{
+    const Move mv = m.toMove();
+    std::printf("(%d,%d)->(%d,%d)", mv.from.row, mv.from.col, mv.to.row, mv.to.col);
+}
+
+static void printScore(int score)
+{
+    if (isMateScore(score))
+    {
+        // Число ходов (не полуходов) до мата; отрицательное — мат нам
+        const int plies = score > 0 ? SCORE_MATE - score : -SCORE_MATE - score;
+        std::printf("мат %d", plies > 0 ? (plies + 1) / 2 : (plies - 1) / 2);
+    }
+    else
+    {
+        std::printf("%d", score);
+    }
+}
+
+static void printIteration(const SearchResult &r)
+{
+    std::printf("глубина %d, оценка ", r.depth);
+    printScore(r.score);
+    std::printf(", узлов: %llu, время: %.3f с, %llu узлов/с, хеш: %d‰, отсечений первым ходом: %.1f%%, "
+                "кэш пешек: %.1f%%, PV:",
+                static_cast<unsigned long long>(r.nodes), r.seconds,
+                static_cast<unsigned long long>(r.nps), r.hashfull,
+                100.0 * r.firstMoveCutoffRate(), 100.0 * r.pawnHitRate());
+
+    for (PackedMove m : r.pv)
+    {
+        std::printf(" ");
+        printMove(m);
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    SearchLimits limits;
+    limits.depth      = (argc > 1) ? std::atoi(argv[1]) : 6;
+    limits.moveTimeMs = (argc > 2) ? std::atoll(argv[2]) : 0;
+
+    const long long hashMb = (argc > 3) ? std::atoll(argv[3])
+                                        : static_cast<long long>(TranspositionTable::DEFAULT_MB);
+
+    if ((limits.depth < 1 && limits.moveTimeMs <= 0) || hashMb < 1)
+    {
+        std::printf("Использование: %s [глубина] [время_мс] [хеш_МБ]\n", argv[0]);
+        return 1;
+    }
+
+    Board board;
+    board.resetToInitialPosition();
+
+    TranspositionTable tt(static_cast<std::size_t>(hashMb));
+    Searcher searcher(tt);
+    searcher.prepare();
+    const SearchResult result = searcher.search(board, limits, printIteration);
+
+    if (result.bestMove.isNone())
+    {
+        std::printf("ходов нет\n");
+        return 0;
+    }
+
+    std::printf("лучший ход: ");
+    printMove(result.bestMove);
+    std::printf("\n");
+    return 0;
+}
@@ -0,0 +1,125 @@
+// tools/book.cpp
+//
+// Дебютная книга (db/OpeningBook.hpp): построение из архивов партий —
+// текстовых (GameReader) или бинарных (GameFile) — и просмотр ходов книги
+// из позиции со временем поиска.
+//
+//   omega_book build <книга> <архив>... [--plies N] [--min-games N]
+//   omega_book probe <книга> [позиция_FEN]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "Clock.hpp"
+#include "Fen.hpp"
+#include "GameFile.hpp"
+#include "Notation.hpp"
+#include "OpeningBook.hpp"
+
+namespace
+{
+    int build(int argc, char *argv[])
+    {
+        int plies    = Db::OpeningBookBuilder::DEFAULT_MAX_PLY;
+        int minGames = Db::OpeningBookBuilder::DEFAULT_MIN_GAMES;
+        std::vector<const char *> archives;
+        for (int i = 3; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--plies") == 0 && i + 1 < argc)
+                plies = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--min-games") == 0 && i + 1 < argc)
+                minGames = std::atoi(argv[++i]);
+            else
+                archives.push_back(argv[i]);
+        }
+        if (archives.empty() || plies < 1 || minGames < 1)
+        {
+            std::printf("Использование: %s build <книга> <архив>... [--plies N] [--min-games N]\n", argv[0]);
+            return 1;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        Db::OpeningBookBuilder builder(plies, minGames);
+        for (const char *path : archives)
+        {
+            if (!Db::replayArchive(path, builder))
+            {
+                std::printf("не удалось открыть %s\n", path);
+                return 1;
+            }
+        }
+
+        Db::OpeningBook book;
+        if (!builder.write(argv[2]) || !book.open(argv[2]))
+        {
+            std::printf("не удалось записать %s\n", argv[2]);
+            return 1;
+        }
+        std::printf("партий: %llu, записей книги: %llu, первые %d полуходов, не реже %d раз, %.3f с\n",
+                    static_cast<unsigned long long>(builder.gameCount()),
+                    static_cast<unsigned long long>(book.entryCount()), plies, minGames,
+                    secondsSince(start));
+        return 0;
+    }
+
+    int probe(const char *path, const char *fen)
+    {
+        Db::OpeningBook book;
+        if (!book.open(path))
+        {
+            std::printf("не удалось открыть %s\n", path);
+            return 1;
+        }
+
+        Board board;
+        if (!Fen::parse(fen ? std::string_view(fen) : Fen::START, board))
+        {
+            std::printf("неверная позиция: %s\n", fen);
+            return 1;
+        }
+
+        // Время поиска: среднее по многим повторам (без проверки легальности)
+        constexpr int REPEATS = 100000;
+        Db::BookEntry buffer[64];
+        std::size_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEATS; ++i)
+            sink += book.find(board.hash(), buffer, 64);
+        const double micros = secondsSince(start) * 1e6 / REPEATS;
+
+        const std::vector<Db::BookEntry> entries = book.entries(board);
+        std::uint64_t total = 0;
+        for (const Db::BookEntry &e : entries)
+            total += e.weight;
+
+        std::printf("%s\n", Fen::toString(board).c_str());
+        std::printf("ходов: %zu, поиск %.3f мкс (%zu)\n", entries.size(), micros, sink / REPEATS);
+        for (const Db::BookEntry &e : entries)
+        {
+            std::printf("  %-6s вес %5u (%5.1f%%)  партий %u\n",
+                        Notation::moveToString(e.move).c_str(), e.weight,
+                        total > 0 ? 100.0 * e.weight / static_cast<double>(total) : 0.0, e.games);
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 4 && std::strcmp(argv[1], "build") == 0)
+        return build(argc, argv);
+
+    if (argc >= 3 && std::strcmp(argv[1], "probe") == 0)
+        return probe(argv[2], argc > 3 ? argv[3] : nullptr);
+
+    std::printf("Использование: %s build <книга> <архив>... [--plies N] [--min-games N]\n"
+                "               %s probe <книга> [позиция_FEN]\n",
+                argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,116 @@
+// tools/eval_bench.cpp
+//
+// Скорость оценки позиции: сколько оценок в секунду даёт инкрементальный
+// материал и PSQT (суммы, которые ведёт Board) по сравнению с пересчётом
+// с нуля по всем фигурам, и полная оценка Eval::evaluate с разбором
+// пешечной структуры с нуля и из кэша (PawnTable). Позиции набираются
+// случайными партиями из начальной позиции.
+//
+//   omega_eval_bench [позиций] [повторов]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Board.hpp"
+#include "Clock.hpp"
+#include "Evaluate.hpp"
+#include "MoveGen.hpp"
+
+static void printRate(const char *name, std::uint64_t evals, double seconds, long long checksum)
+{
+    const double rate = seconds > 0.0 ? static_cast<double>(evals) / seconds : 0.0;
+    std::printf("%s: %llu оценок за %.3f с, %.0f оценок/с (контрольная сумма %lld)\n",
+                name, static_cast<unsigned long long>(evals), seconds, rate, checksum);
+}
+
+int main(int argc, char *argv[])
+{
+    const int positions = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    const int repeats   = (argc > 2) ? std::atoi(argv[2]) : 100;
+
+    if (positions < 1 || repeats < 1)
+    {
+        std::printf("Использование: %s [позиций] [повторов]\n", argv[0]);
+        return 1;
+    }
+
+    // Набор позиций: случайные партии по 80 полуходов
+    std::vector<Board> boards;
+    boards.reserve(static_cast<std::size_t>(positions));
+
+    std::mt19937 rng(1);
+    Board board;
+    board.resetToInitialPosition();
+    while (static_cast<int>(boards.size()) < positions)
+    {
+        MoveList moves;
+        MoveGen::generateLegal(board, moves);
+        if (moves.empty() || (boards.size() % 80) == 79)
+            board.resetToInitialPosition();
+        else
+            board.makeMove(moves[static_cast<int>(rng() % moves.size())]);
+        boards.push_back(board);
+    }
+
+    const std::uint64_t evals = static_cast<std::uint64_t>(positions) * static_cast<std::uint64_t>(repeats);
+
+    {
+        long long checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (const Board &b : boards)
+            {
+                const int white = Eval::taper(b.psqt(), b.phase());
+                checksum += (b.sideToMove() == PieceColor::White) ? white : -white;
+            }
+        }
+        printRate("PSQT инкрементально", evals, secondsSince(start), checksum);
+    }
+
+    {
+        long long checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (const Board &b : boards)
+            {
+                int phase = 0;
+                Bitboard occ = b.occupied();
+                while (occ.any())
+                    phase += Psqt::phaseWeight(b.pieceAt(occ.popLsb()).kind);
+
+                const int white = Eval::taper(b.computePsqt(), phase);
+                checksum += (b.sideToMove() == PieceColor::White) ? white : -white;
+            }
+        }
+        printRate("PSQT с нуля        ", evals, secondsSince(start), checksum);
+    }
+
+    {
+        long long checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+            for (const Board &b : boards)
+                checksum += Eval::evaluate(b);
+        printRate("пешки с нуля       ", evals, secondsSince(start), checksum);
+    }
+
+    {
+        PawnTable pawns;
+        long long checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+            for (const Board &b : boards)
+                checksum += Eval::evaluate(b, pawns);
+        printRate("пешки из кэша      ", evals, secondsSince(start), checksum);
+        std::printf("попаданий в кэш пешек: %.1f%%\n",
+                    pawns.probes() > 0 ? 100.0 * static_cast<double>(pawns.hits()) / static_cast<double>(pawns.probes()) : 0.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+// tools/fen_bench.cpp
+//
+// Скорость разбора и записи позиций в духе FEN (logic/Fen.hpp): сколько
+// позиций в секунду читает Fen::parse из одного текстового буфера (как
+// при загрузке больших наборов позиций для анализа) и сколько пишет
+// Fen::write. Позиции набираются случайными партиями из начальной позиции.
+//
+//   omega_fen_bench [позиций] [повторов]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "Clock.hpp"
+#include "Fen.hpp"
+#include "MoveGen.hpp"
+
+static void printRate(const char *name, std::uint64_t count, std::uint64_t bytes, double seconds,
+                      std::uint64_t checksum)
+{
+    const double rate = seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+    const double mbps = seconds > 0.0 ? static_cast<double>(bytes) / seconds / (1024.0 * 1024.0) : 0.0;
+    std::printf("%s: %llu позиций за %.3f с, %.0f позиций/с, %.1f МБ/с (контрольная сумма %llu)\n",
+                name, static_cast<unsigned long long>(count), seconds, rate, mbps,
+                static_cast<unsigned long long>(checksum));
+}
+
+int main(int argc, char *argv[])
+{
+    const int positions = (argc > 1) ? std::atoi(argv[1]) : 100000;
+    const int repeats   = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+    if (positions < 1 || repeats < 1)
+    {
+        std::printf("Использование: %s [позиций] [повторов]\n", argv[0]);
+        return 1;
+    }
+
+    // Набор позиций: случайные партии по 80 полуходов
+    std::vector<Board> boards;
+    boards.reserve(static_cast<std::size_t>(positions));
+
+    std::mt19937 rng(1);
+    Board board;
+    board.resetToInitialPosition();
+    while (static_cast<int>(boards.size()) < positions)
+    {
+        MoveList moves;
+        MoveGen::generateLegal(board, moves);
+        if (moves.empty() || (boards.size() % 80) == 79)
+            board.resetToInitialPosition();
+        else
+            board.makeMove(moves[static_cast<int>(rng() % moves.size())]);
+        boards.push_back(board);
+    }
+
+    // Все записи подряд в одном буфере, по строке на позицию
+    std::string text;
+    text.reserve(static_cast<std::size_t>(positions) * 64);
+    for (const Board &b : boards)
+    {
+        char line[Fen::MAX_LENGTH];
+        const std::size_t n = Fen::write(b, line, sizeof(line));
+        text.append(line, n);
+        text.push_back('\n');
+    }
+
+    const std::uint64_t count = static_cast<std::uint64_t>(positions) * static_cast<std::uint64_t>(repeats);
+    const std::uint64_t bytes = static_cast<std::uint64_t>(text.size()) * static_cast<std::uint64_t>(repeats);
+
+    {
+        std::uint64_t checksum = 0;
+        std::uint64_t failed   = 0;
+        Board parsed;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            std::string_view rest = text;
+            while (!rest.empty())
+            {
+                const std::size_t end = rest.find('\n');
+                if (Fen::parse(rest.substr(0, end), parsed))
+                    checksum += parsed.hash();
+                else
+                    ++failed;
+                rest.remove_prefix(end + 1);
+            }
+        }
+        printRate("разбор", count, bytes, secondsSince(start), checksum);
+        if (failed > 0)
+        {
+            std::printf("ошибок разбора: %llu\n", static_cast<unsigned long long>(failed));
+            return 1;
+        }
+    }
+
+    {
+        std::uint64_t checksum = 0;
+        char line[Fen::MAX_LENGTH];
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (const Board &b : boards)
+                checksum += Fen::write(b, line, sizeof(line)) + static_cast<unsigned char>(line[0]);
+        }
+        printRate("запись", count, bytes, secondsSince(start), checksum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+// tools/game_convert.cpp
+//
+// Преобразование архивов партий между текстовым форматом (db/GameReader.hpp)
+// и компактным бинарным (db/GameFile.hpp: ход — 2 байта, индекс партий),
+// и замер чтения бинарного архива: проигрывание всех партий подряд и
+// доступ к случайным партиям по индексу.
+//
+//   omega_game_convert pack   <текст> <бинарный>
+//   omega_game_convert unpack <бинарный> <текст>
+//   omega_game_convert bench  <бинарный> [случайных_партий]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "Clock.hpp"
+#include "GameFile.hpp"
+
+namespace
+{
+    long long fileSize(const char *path)
+    {
+        std::FILE *f = std::fopen(path, "rb");
+        if (!f)
+            return -1;
+        std::fseek(f, 0, SEEK_END);
+        const long long size = std::ftell(f);
+        std::fclose(f);
+        return size;
+    }
+
+    void printSizes(const char *textPath, const char *binaryPath)
+    {
+        const long long text   = fileSize(textPath);
+        const long long binary = fileSize(binaryPath);
+        std::printf("текст: %lld байт, бинарный: %lld байт, сжатие в %.1f раза\n",
+                    text, binary, binary > 0 ? static_cast<double>(text) / static_cast<double>(binary) : 0.0);
+    }
+
+    // Считает ходы и XOR ключей позиций — чтобы было что сверить
+    class CountingVisitor : public Db::GameVisitor
+    {
+    public:
+        void move(const Board &before, PackedMove move) override
+        {
+            (void)move;
+            checksum ^= before.hash();
+            ++moves;
+        }
+
+        std::uint64_t moves    = 0;
+        std::uint64_t checksum = 0;
+    };
+
+    int bench(const char *path, long long samples)
+    {
+        const auto openStart = std::chrono::steady_clock::now();
+        Db::GameFile games;
+        if (!games.open(path))
+        {
+            std::printf("не удалось открыть %s\n", path);
+            return 1;
+        }
+        std::printf("открыт за %.6f с, партий: %llu\n", secondsSince(openStart),
+                    static_cast<unsigned long long>(games.gameCount()));
+
+        {
+            CountingVisitor visitor;
+            std::uint64_t broken = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < games.gameCount(); ++i)
+            {
+                Db::GameView game;
+                if (!games.game(i, game) || !game.replay(visitor))
+                    ++broken;
+            }
+            const double seconds = secondsSince(start);
+            std::printf("подряд: %.3f с, %.0f партий/с, %.0f ходов/с, испорченных: %llu (контрольная сумма %016llx)\n",
+                        seconds,
+                        seconds > 0.0 ? static_cast<double>(games.gameCount()) / seconds : 0.0,
+                        seconds > 0.0 ? static_cast<double>(visitor.moves) / seconds : 0.0,
+                        static_cast<unsigned long long>(broken),
+                        static_cast<unsigned long long>(visitor.checksum));
+        }
+
+        if (games.gameCount() > 0 && samples > 0)
+        {
+            // Случайный доступ: только поиск партии по индексу и чтение её ходов
+            std::mt19937_64 rng(1);
+            std::uint64_t sum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (long long s = 0; s < samples; ++s)
+            {
+                Db::GameView game;
+                if (games.game(rng() % games.gameCount(), game))
+                {
+                    for (int i = 0; i < game.plies; ++i)
+                        sum += game.move(i).raw();
+                }
+            }
+            const double seconds = secondsSince(start);
+            std::printf("случайный доступ: %lld партий за %.3f с, %.0f партий/с (сумма %llu)\n",
+                        samples, seconds, seconds > 0.0 ? static_cast<double>(samples) / seconds : 0.0,
+                        static_cast<unsigned long long>(sum));
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 4 && std::strcmp(argv[1], "pack") == 0)
+    {
+        Db::ReaderStats stats;
+        const auto start = std::chrono::steady_clock::now();
+        if (!Db::textToBinary(argv[2], argv[3], &stats))
+        {
+            std::printf("не удалось преобразовать %s в %s\n", argv[2], argv[3]);
+            return 1;
+        }
+        std::printf("партий: %llu (пропущено ошибочных: %llu), ходов: %llu за %.3f с\n",
+                    static_cast<unsigned long long>(stats.games),
+                    static_cast<unsigned long long>(stats.invalidGames),
+                    static_cast<unsigned long long>(stats.moves), secondsSince(start));
+        printSizes(argv[2], argv[3]);
+        return 0;
+    }
+
+    if (argc >= 4 && std::strcmp(argv[1], "unpack") == 0)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (!Db::binaryToText(argv[2], argv[3]))
+        {
+            std::printf("не удалось преобразовать %s в %s\n", argv[2], argv[3]);
+            return 1;
+        }
+        std::printf("готово за %.3f с\n", secondsSince(start));
+        printSizes(argv[3], argv[2]);
+        return 0;
+    }
+
+    if (argc >= 3 && std::strcmp(argv[1], "bench") == 0)
+    {
+        const long long samples = (argc > 3) ? std::atoll(argv[3]) : 1000000;
+        return bench(argv[2], samples);
+    }
+
+    std::printf("Использование: %s pack <текст> <бинарный>\n"
+                "               %s unpack <бинарный> <текст>\n"
+                "               %s bench <бинарный> [случайных_партий]\n",
+                argv[0], argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,170 @@
+// tools/nnue_bench.cpp
+//
+// Скорость NNUE-оценки: оценок в секунду у скалярного эталона (аккумулятор
+// считается с нуля по всем фигурам) и у инкрементального обновления
+// аккумуляторов вдоль партий для каждого набора инструкций, который есть
+// у процессора (скаляр, SSE4.1, AVX2). Контрольные суммы всех вариантов
+// обязаны совпасть.
+//
+// Веса — из файла или случайные (файл тогда можно сохранить):
+//
+//   omega_nnue_bench [партий] [повторов] [веса.nnue] [--save]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Board.hpp"
+#include "Clock.hpp"
+#include "MoveGen.hpp"
+#include "Nnue.hpp"
+
+namespace
+{
+    // Партия: ходы из начальной позиции
+    using Game = std::vector<PackedMove>;
+
+    constexpr int GAME_PLIES = 80;
+}
+
+static void printRate(const char *name, std::uint64_t evals, double seconds, long long checksum)
+{
+    const double rate = seconds > 0.0 ? static_cast<double>(evals) / seconds : 0.0;
+    std::printf("%s %llu оценок за %.3f с, %.0f оценок/с (контрольная сумма %lld)\n",
+                name, static_cast<unsigned long long>(evals), seconds, rate, checksum);
+}
+
+int main(int argc, char *argv[])
+{
+    const int   gameCount = (argc > 1) ? std::atoi(argv[1]) : 200;
+    const int   repeats   = (argc > 2) ? std::atoi(argv[2]) : 20;
+    const char *path      = (argc > 3) ? argv[3] : nullptr;
+    const bool  save      = (argc > 4) && std::strcmp(argv[4], "--save") == 0;
+
+    if (gameCount < 1 || repeats < 1)
+    {
+        std::printf("Использование: %s [партий] [повторов] [веса.nnue] [--save]\n", argv[0]);
+        return 1;
+    }
+
+    Nnue::Network network;
+    if (path && !save)
+    {
+        if (!network.load(path))
+        {
+            std::printf("Не удалось загрузить веса: %s\n", path);
+            return 1;
+        }
+        std::printf("Веса: %s\n", path);
+    }
+    else
+    {
+        network = Nnue::Network::random(1);
+        std::printf("Веса: случайные\n");
+        if (path && !network.save(path))
+        {
+            std::printf("Не удалось сохранить веса: %s\n", path);
+            return 1;
+        }
+    }
+
+    // Случайные партии и все позиции из них
+    std::vector<Game>  games;
+    std::vector<Board> boards;
+
+    std::mt19937 rng(1);
+    for (int g = 0; g < gameCount; ++g)
+    {
+        Board board;
+        board.resetToInitialPosition();
+
+        Game game;
+        for (int ply = 0; ply < GAME_PLIES; ++ply)
+        {
+            MoveList moves;
+            MoveGen::generateLegal(board, moves);
+            if (moves.empty())
+                break;
+
+            const PackedMove m = moves[static_cast<int>(rng() % moves.size())];
+            board.makeMove(m);
+            game.push_back(m);
+            boards.push_back(board);
+        }
+        games.push_back(game);
+    }
+
+    const std::uint64_t evals = static_cast<std::uint64_t>(boards.size()) * static_cast<std::uint64_t>(repeats);
+
+    std::printf("Позиций: %zu, повторов: %d, процессор: %s\n",
+                boards.size(), repeats, Nnue::isaName(Nnue::detectIsa()));
+
+    // Эталон: скалярные ядра, аккумулятор с нуля
+    long long reference = 0;
+    {
+        Nnue::Evaluator eval(network, Nnue::Isa::Scalar);
+        Nnue::Accumulator acc;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (const Board &b : boards)
+            {
+                eval.refresh(b, acc);
+                reference += eval.evaluate(acc, b.sideToMove());
+            }
+        }
+        printRate("скаляр, с нуля:", evals, secondsSince(start), reference);
+    }
+
+    bool ok = true;
+    const Nnue::Isa isas[] = {Nnue::Isa::Scalar, Nnue::Isa::Sse41, Nnue::Isa::Avx2};
+
+    for (Nnue::Isa isa : isas)
+    {
+        if (!Nnue::isSupported(isa))
+        {
+            std::printf("%s: не поддерживается процессором\n", Nnue::isaName(isa));
+            continue;
+        }
+
+        // Инкрементально: ход по партии, обновление аккумулятора, оценка
+        Nnue::Evaluator eval(network, isa);
+        long long checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (const Game &game : games)
+            {
+                Board board;
+                board.resetToInitialPosition();
+                eval.reset(board);
+
+                for (PackedMove m : game)
+                {
+                    UndoInfo undo;
+                    board.makeMove(m, undo);
+                    eval.push(board, m, undo);
+                    checksum += eval.evaluate(board);
+                }
+            }
+        }
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s, инкрементально:", Nnue::isaName(isa));
+        printRate(name, evals, secondsSince(start), checksum);
+
+        if (checksum != reference)
+        {
+            std::printf("ОШИБКА: контрольная сумма %s не совпала с эталоном\n", Nnue::isaName(isa));
+            ok = false;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
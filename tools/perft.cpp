@@ -0,0 +1,88 @@
+// tools/perft.cpp
+//
+// Подсчёт листьев дерева легальных ходов (perft) из начальной позиции.
+// Используется для проверки генератора ходов и как бенчмарк.
+//
+//   omega_perft <depth> [divide]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Board.hpp"
+#include "Clock.hpp"
+#include "MoveGen.hpp"
+
+static void printUsage(const char *argv0)
+{
+    std::printf("Использование: %s <глубина> [divide]\n", argv0);
+}
+
+static void printRate(std::uint64_t nodes, double seconds)
+{
+    const double nps = seconds > 0.0 ? static_cast<double>(nodes) / seconds : 0.0;
+    std::printf("узлов: %llu, время: %.3f с, %.0f узлов/с\n",
+                static_cast<unsigned long long>(nodes), seconds, nps);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const int depth = std::atoi(argv[1]);
+    if (depth < 1)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const bool divide = (argc > 2 && std::strcmp(argv[2], "divide") == 0);
+
+    Board board;
+    board.resetToInitialPosition();
+
+    if (divide)
+    {
+        // Разбивка по первым ходам — для поиска расхождений
+        const auto start = std::chrono::steady_clock::now();
+
+        MoveList moves;
+        MoveGen::generateLegal(board, moves);
+
+        std::uint64_t total = 0;
+        for (PackedMove m : moves)
+        {
+            UndoInfo undo;
+            board.makeMove(m, undo);
+            const std::uint64_t nodes = MoveGen::perft(board, depth - 1);
+            board.unmakeMove(m, undo);
+            total += nodes;
+
+            const Move mv = m.toMove();
+            std::printf("(%d,%d) -> (%d,%d): %llu\n",
+                        mv.from.row, mv.from.col, mv.to.row, mv.to.col,
+                        static_cast<unsigned long long>(nodes));
+        }
+
+        std::printf("perft(%d) = %llu\n", depth, static_cast<unsigned long long>(total));
+        printRate(total, secondsSince(start));
+        return 0;
+    }
+
+    for (int d = 1; d <= depth; ++d)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t nodes = MoveGen::perft(board, d);
+
+        std::printf("perft(%d) = %llu; ", d, static_cast<unsigned long long>(nodes));
+        printRate(nodes, secondsSince(start));
+    }
+
+    return 0;
+}
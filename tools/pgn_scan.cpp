@@ -0,0 +1,166 @@
+// tools/pgn_scan.cpp
+//
+// Потоковое чтение архива партий (db/GameReader.hpp): все ходы проверяются
+// правилами и применяются к доске, в конце печатаются число партий, ходов,
+// ошибочных партий и скорость (партий/с, МБ/с). Память не зависит от
+// размера файла — он читается кусками в буфер фиксированного размера.
+//
+// Для замеров архив можно сгенерировать: случайные партии с тегами,
+// номерами ходов и изредка комментариями.
+//
+//   omega_pgn_scan <файл> [буфер_КБ]
+//   omega_pgn_scan --generate <партий> <файл> [seed]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "Board.hpp"
+#include "GameReader.hpp"
+#include "MoveGen.hpp"
+#include "Notation.hpp"
+#include "Rules.hpp"
+
+namespace
+{
+    // Считает позиции и XOR их ключей — чтобы было что сверить
+    class CountingVisitor : public Db::GameVisitor
+    {
+    public:
+        void move(const Board &before, PackedMove move) override
+        {
+            (void)move;
+            m_checksum ^= before.hash();
+        }
+
+        void endGame(const Db::GameSummary &summary) override
+        {
+            ++m_results[static_cast<int>(summary.result)];
+        }
+
+        std::uint64_t checksum() const noexcept { return m_checksum; }
+        std::uint64_t results(Db::GameResult r) const noexcept { return m_results[static_cast<int>(r)]; }
+
+    private:
+        std::uint64_t m_checksum   = 0;
+        std::uint64_t m_results[4] = {};
+    };
+
+    int generate(long long games, const char *path, unsigned seed)
+    {
+        std::FILE *out = std::fopen(path, "wb");
+        if (!out)
+        {
+            std::printf("не удалось создать %s\n", path);
+            return 1;
+        }
+
+        std::mt19937 rng(seed);
+        for (long long g = 0; g < games; ++g)
+        {
+            Board board;
+            board.resetToInitialPosition();
+
+            std::string moves;
+            std::size_t lineStart = 0;
+            const char *result = "*";
+
+            for (int ply = 0; ply < 160; ++ply)
+            {
+                MoveList legal;
+                MoveGen::generateLegal(board, legal);
+                if (legal.empty())
+                {
+                    const PieceColor side = board.sideToMove();
+                    if (Rules::isKingInCheck(board, side))
+                        result = side == PieceColor::White ? "0-1" : "1-0";
+                    else
+                        result = "1/2-1/2";
+                    break;
+                }
+
+                if (ply % 2 == 0)
+                    moves += std::to_string(ply / 2 + 1) + ". ";
+
+                const PackedMove m = legal[static_cast<int>(rng() % legal.size())];
+                moves += Notation::moveToString(m);
+                if (rng() % 40 == 0)
+                    moves += " {случайный ход}";
+                moves += ' ';
+                board.makeMove(m);
+
+                if (moves.size() - lineStart > 72)
+                {
+                    moves.back() = '\n';
+                    lineStart = moves.size();
+                }
+            }
+
+            std::fprintf(out, "[Event \"Случайная партия\"]\n[Round \"%lld\"]\n[Result \"%s\"]\n\n%s%s\n\n",
+                         g + 1, result, moves.c_str(), result);
+        }
+
+        std::fclose(out);
+        std::printf("записано партий: %lld в %s\n", games, path);
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 4 && std::strcmp(argv[1], "--generate") == 0)
+    {
+        const long long games = std::atoll(argv[2]);
+        const unsigned  seed  = (argc > 4) ? static_cast<unsigned>(std::atoi(argv[4])) : 1u;
+        if (games < 1)
+        {
+            std::printf("Использование: %s --generate <партий> <файл> [seed]\n", argv[0]);
+            return 1;
+        }
+        return generate(games, argv[3], seed);
+    }
+
+    if (argc < 2 || argv[1][0] == '-')
+    {
+        std::printf("Использование: %s <файл> [буфер_КБ]\n"
+                    "               %s --generate <партий> <файл> [seed]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    const long long bufferKb = (argc > 2) ? std::atoll(argv[2])
+                                          : static_cast<long long>(Db::GameReader::DEFAULT_BUFFER / 1024);
+    if (bufferKb < 1)
+    {
+        std::printf("Использование: %s <файл> [буфер_КБ]\n", argv[0]);
+        return 1;
+    }
+
+    CountingVisitor visitor;
+    Db::GameReader reader(visitor, static_cast<std::size_t>(bufferKb) * 1024);
+    if (!reader.readFile(argv[1]))
+    {
+        std::printf("не удалось открыть %s\n", argv[1]);
+        return 1;
+    }
+
+    const Db::ReaderStats &s = reader.stats();
+    const double mb = static_cast<double>(s.bytes) / (1024.0 * 1024.0);
+    std::printf("партий: %llu (ошибочных: %llu), ходов: %llu, %.1f МБ за %.3f с\n",
+                static_cast<unsigned long long>(s.games),
+                static_cast<unsigned long long>(s.invalidGames),
+                static_cast<unsigned long long>(s.moves), mb, s.seconds);
+    std::printf("%.0f партий/с, %.0f ходов/с, %.1f МБ/с, буфер %lld КБ\n",
+                s.gamesPerSecond(),
+                s.seconds > 0.0 ? static_cast<double>(s.moves) / s.seconds : 0.0,
+                s.seconds > 0.0 ? mb / s.seconds : 0.0, bufferKb);
+    std::printf("результаты: 1-0 %llu, 0-1 %llu, 1/2-1/2 %llu, * %llu; контрольная сумма %016llx\n",
+                static_cast<unsigned long long>(visitor.results(Db::GameResult::WhiteWin)),
+                static_cast<unsigned long long>(visitor.results(Db::GameResult::BlackWin)),
+                static_cast<unsigned long long>(visitor.results(Db::GameResult::Draw)),
+                static_cast<unsigned long long>(visitor.results(Db::GameResult::Unknown)),
+                static_cast<unsigned long long>(visitor.checksum()));
+    return 0;
+}
@@ -0,0 +1,187 @@
+// tools/position_index.cpp
+//
+// База позиций (db/PositionIndex.hpp): построение из архивов партий —
+// текстовых (GameReader) или бинарных (GameFile), запрос статистики ходов
+// из позиции и замер скорости поиска по позициям партий архива.
+//
+//   omega_position_index build <база> <архив>... [--plies N]
+//   omega_position_index query <база> [позиция_FEN]
+//   omega_position_index bench <база> <архив>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "Clock.hpp"
+#include "Fen.hpp"
+#include "GameFile.hpp"
+#include "GameReader.hpp"
+#include "Notation.hpp"
+#include "PositionIndex.hpp"
+
+namespace
+{
+    // Ключи позиций архива — для замера поиска
+    class KeyCollector : public Db::GameVisitor
+    {
+    public:
+        void move(const Board &before, PackedMove move) override
+        {
+            (void)move;
+            if (keys.size() < LIMIT)
+                keys.push_back(before.hash());
+        }
+
+        static constexpr std::size_t LIMIT = 1000000;
+
+        std::vector<std::uint64_t> keys;
+    };
+
+    double percent(std::uint32_t part, std::uint32_t whole)
+    {
+        return whole > 0 ? 100.0 * part / whole : 0.0;
+    }
+
+    int build(int argc, char *argv[])
+    {
+        int plies = Db::PositionIndexBuilder::DEFAULT_MAX_PLY;
+        std::vector<const char *> archives;
+        for (int i = 3; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--plies") == 0 && i + 1 < argc)
+                plies = std::atoi(argv[++i]);
+            else
+                archives.push_back(argv[i]);
+        }
+        if (archives.empty() || plies < 1)
+        {
+            std::printf("Использование: %s build <база> <архив>... [--plies N]\n", argv[0]);
+            return 1;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        Db::PositionIndexBuilder builder(plies);
+        for (const char *path : archives)
+        {
+            if (!Db::replayArchive(path, builder))
+            {
+                std::printf("не удалось открыть %s\n", path);
+                return 1;
+            }
+        }
+
+        if (!builder.write(argv[2]))
+        {
+            std::printf("не удалось записать %s\n", argv[2]);
+            return 1;
+        }
+
+        Db::PositionIndex index;
+        if (!index.open(argv[2]))
+        {
+            std::printf("не удалось открыть %s\n", argv[2]);
+            return 1;
+        }
+        std::printf("партий: %llu, записей (позиция, ход): %llu, первые %d полуходов, %.3f с\n",
+                    static_cast<unsigned long long>(index.gameCount()),
+                    static_cast<unsigned long long>(index.entryCount()), plies, secondsSince(start));
+        return 0;
+    }
+
+    int query(const char *path, const char *fen)
+    {
+        Db::PositionIndex index;
+        if (!index.open(path))
+        {
+            std::printf("не удалось открыть %s\n", path);
+            return 1;
+        }
+
+        Board board;
+        if (!Fen::parse(fen ? std::string_view(fen) : Fen::START, board))
+        {
+            std::printf("неверная позиция: %s\n", fen);
+            return 1;
+        }
+
+        const std::vector<Db::MoveStats> moves = index.moves(board);
+
+        // Время одного поиска: среднее по многим повторам
+        constexpr int REPEATS = 100000;
+        Db::MoveStats buffer[256];
+        std::size_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEATS; ++i)
+            sink += index.find(board.hash(), buffer, 256);
+        const double micros = secondsSince(start) * 1e6 / REPEATS;
+
+        std::printf("%s\n", Fen::toString(board).c_str());
+        std::printf("ходов: %zu, поиск %.3f мкс (%zu)\n", moves.size(), micros, sink / REPEATS);
+        for (const Db::MoveStats &m : moves)
+        {
+            std::printf("  %-6s партий %8u  1-0 %5.1f%%  0-1 %5.1f%%  1/2 %5.1f%%\n",
+                        Notation::moveToString(m.move).c_str(), m.games,
+                        percent(m.whiteWins, m.games), percent(m.blackWins, m.games),
+                        percent(m.draws, m.games));
+        }
+        return 0;
+    }
+
+    int bench(const char *path, const char *archive)
+    {
+        Db::PositionIndex index;
+        if (!index.open(path))
+        {
+            std::printf("не удалось открыть %s\n", path);
+            return 1;
+        }
+
+        KeyCollector collector;
+        if (!Db::replayArchive(archive, collector) || collector.keys.empty())
+        {
+            std::printf("нет позиций в %s\n", archive);
+            return 1;
+        }
+
+        Db::MoveStats buffer[256];
+        std::uint64_t hits = 0;
+        std::uint64_t found = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t key : collector.keys)
+        {
+            const std::size_t n = index.find(key, buffer, 256);
+            hits  += n > 0 ? 1 : 0;
+            found += n;
+        }
+        const double seconds = secondsSince(start);
+        std::printf("поисков: %zu (найдено позиций: %llu, ходов: %llu) за %.3f с, %.3f мкс на поиск\n",
+                    collector.keys.size(), static_cast<unsigned long long>(hits),
+                    static_cast<unsigned long long>(found), seconds,
+                    seconds * 1e6 / static_cast<double>(collector.keys.size()));
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 4 && std::strcmp(argv[1], "build") == 0)
+        return build(argc, argv);
+
+    if (argc >= 3 && std::strcmp(argv[1], "query") == 0)
+        return query(argv[2], argc > 3 ? argv[3] : nullptr);
+
+    if (argc >= 4 && std::strcmp(argv[1], "bench") == 0)
+        return bench(argv[2], argv[3]);
+
+    std::printf("Использование: %s build <база> <архив>... [--plies N]\n"
+                "               %s query <база> [позиция_FEN]\n"
+                "               %s bench <база> <архив>\n",
+                argv[0], argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,81 @@
+// tools/smp_bench.cpp
+//
+// Масштабирование многопоточного поиска (Lazy SMP): поиск до фиксированной
+// глубины из начальной позиции при 1, 2, 4, 8, … потоках и при максимальном
+// числе потоков. Для каждого — время до глубины, узлы, скорость и ускорение
+// относительно одного потока. Таблица транспозиций очищается перед каждым
+// прогоном.
+//
+//   omega_smp_bench [глубина] [макс_потоков] [хеш_МБ]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "SmpSearch.hpp"
+
+int main(int argc, char *argv[])
+{
+    const int depth = (argc > 1) ? std::atoi(argv[1]) : 7;
+
+    int maxThreads = (argc > 2) ? std::atoi(argv[2])
+                                : static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    const long long hashMb = (argc > 3) ? std::atoll(argv[3]) : 64;
+
+    if (depth < 1 || depth >= MAX_PLY || hashMb < 1)
+    {
+        std::printf("Использование: %s [глубина] [макс_потоков] [хеш_МБ]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<int> counts;
+    for (int n = 1; n < maxThreads; n *= 2)
+        counts.push_back(n);
+    counts.push_back(maxThreads);
+
+    Board board;
+    board.resetToInitialPosition();
+
+    ParallelSearch search(1, static_cast<std::size_t>(hashMb));
+
+    SearchLimits limits;
+    limits.depth = depth;
+
+    std::printf("глубина %d, таблица %lld МБ\n", depth, hashMb);
+    std::printf(" потоков   время, с          узлов        узлов/с  ускорение      NPS x\n");
+
+    double baseTime = 0.0;
+    double baseNps  = 0.0;
+
+    for (int n : counts)
+    {
+        search.setThreadCount(n);
+        search.tt().clear();
+
+        search.prepare();
+        const SearchResult r = search.search(board, limits);
+
+        if (n == 1)
+        {
+            baseTime = r.seconds;
+            baseNps  = static_cast<double>(r.nps);
+        }
+
+        const double speedup = r.seconds > 0.0 ? baseTime / r.seconds : 0.0;
+        const double npsGain = baseNps > 0.0 ? static_cast<double>(r.nps) / baseNps : 0.0;
+
+        std::printf("%8d %10.3f %14llu %14llu %10.2f %10.2f\n",
+                    n, r.seconds,
+                    static_cast<unsigned long long>(r.nodes),
+                    static_cast<unsigned long long>(r.nps),
+                    speedup, npsGain);
+    }
+
+    return 0;
+}
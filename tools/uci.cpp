@@ -0,0 +1,386 @@
+// tools/uci.cpp
+//
+// Движок Omega Chess без GUI и Qt: текстовый протокол в духе UCI через
+// stdin/stdout, для серверов анализа и турнирных оболочек. Ходы и клетки —
+// в записи Notation (a0..j9, углы w1..w4), например «e1e3», «w1c3».
+//
+// Команды:
+//   uci                                   — имя, опции, uciok
+//   isready                               — readyok (после завершения настройки)
+//   setoption name Hash value <МБ>
+//   setoption name Threads value <n>
+//   setoption name EvalFile value <путь>  — веса NNUE; пусто — PSQT
+//   setoption name BookFile value <путь>  — дебютная книга; пусто — без книги
+//   ucinewgame                            — очистить таблицу транспозиций
+//   position startpos [moves <ход> ...]
+//   position fen <позиция> [moves <ход> ...]  — запись Fen.hpp
+//   go [depth N] [movetime мс] [nodes N] [infinite]
+//      [wtime мс] [btime мс] [winc мс] [binc мс] [movestogo N]
+//   stop                                  — прервать поиск, вывести bestmove
+//   quit                                  — прервать поиск и выйти
+//
+// Поиск идёт в отдельном потоке, а главный поток всё это время читает
+// команды, поэтому «stop» доходит до поиска сразу: флаг остановки
+// проверяется в каждом узле. После каждой итерации печатается строка
+// info (глубина, оценка, узлы, nps, hashfull, время, PV). Если позиция
+// есть в дебютной книге, go (кроме go infinite) сразу отвечает её ходом.
+// С часами (wtime/btime) и без movetime время на ход берётся из остатка
+// стороны хода: остаток / movestogo (без него — на 30 ходов) плюс
+// половина добавки, но не больше остатка за вычетом запаса на связь.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "Fen.hpp"
+#include "Notation.hpp"
+#include "Nnue.hpp"
+#include "OpeningBook.hpp"
+#include "SmpSearch.hpp"
+
+namespace
+{
+    constexpr int MAX_HASH_MB = 65536;
+    constexpr int MAX_THREADS = 256;
+
+    // Время на ход по часам: на сколько ходов делить остаток без movestogo
+    // и сколько оставлять на задержки связи с оболочкой
+    constexpr long long DEFAULT_MOVES_TO_GO = 30;
+    constexpr long long MOVE_OVERHEAD_MS    = 30;
+
+    std::int64_t moveBudget(long long remaining, long long increment, long long movesToGo)
+    {
+        const long long moves = movesToGo > 0 ? movesToGo : DEFAULT_MOVES_TO_GO;
+        const long long budget = std::min(remaining / moves + increment / 2, remaining - MOVE_OVERHEAD_MS);
+        // Не меньше 1 мс: 0 означал бы поиск без ограничения
+        return std::max(budget, 1LL);
+    }
+
+    class Engine
+    {
+    public:
+        Engine()
+        {
+            m_board.resetToInitialPosition();
+        }
+
+        ~Engine()
+        {
+            stopSearch();
+        }
+
+        // Обработать одну строку; false — пора выходить
+        bool handle(const std::string &line);
+
+        // Дождаться окончания поиска, не прерывая его
+        void waitSearch();
+
+    private:
+        void send(const std::string &text);
+
+        void cmdUci();
+        void cmdSetOption(std::istringstream &in);
+        void cmdPosition(std::istringstream &in);
+        void cmdGo(std::istringstream &in);
+
+        // Остановить идущий поиск и дождаться его bestmove
+        void stopSearch();
+
+        void reportIteration(const SearchResult &r);
+
+        ParallelSearch m_search;
+        Nnue::Network  m_network;
+
+        Db::OpeningBook m_book;
+        std::mt19937_64 m_bookRandom{std::random_device{}()};
+
+        Board                      m_board;
+        std::vector<std::uint64_t> m_history;   // ключи позиций до текущей
+
+        std::thread m_thread;
+        std::mutex  m_outputMutex;
+    };
+
+    bool Engine::handle(const std::string &line)
+    {
+        std::istringstream in(line);
+        std::string cmd;
+        if (!(in >> cmd))
+            return true;
+
+        if (cmd == "uci")
+            cmdUci();
+        else if (cmd == "isready")
+            send("readyok");
+        else if (cmd == "setoption")
+            cmdSetOption(in);
+        else if (cmd == "ucinewgame")
+        {
+            stopSearch();
+            m_search.tt().clear();
+        }
+        else if (cmd == "position")
+            cmdPosition(in);
+        else if (cmd == "go")
+            cmdGo(in);
+        else if (cmd == "stop")
+            stopSearch();
+        else if (cmd == "quit")
+            return false;
+        else
+            send("info string неизвестная команда: " + cmd);
+
+        return true;
+    }
+
+    void Engine::send(const std::string &text)
+    {
+        // Строки пишут и главный поток, и поток поиска
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fputc('\n', stdout);
+        std::fflush(stdout);
+    }
+
+    void Engine::cmdUci()
+    {
+        send("id name OmegaChess");
+        send("id author OmegaChess");
+        send("option name Hash type spin default " + std::to_string(TranspositionTable::DEFAULT_MB) +
+             " min 1 max " + std::to_string(MAX_HASH_MB));
+        send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+        send("option name EvalFile type string default <empty>");
+        send("option name BookFile type string default <empty>");
+        send("uciok");
+    }
+
+    void Engine::cmdSetOption(std::istringstream &in)
+    {
+        // setoption name <имя> value <значение>; имя и значение могут быть из нескольких слов
+        std::string token, name, value;
+        std::string *target = nullptr;
+        while (in >> token)
+        {
+            if (token == "name")
+                target = &name;
+            else if (token == "value")
+                target = &value;
+            else if (target)
+                *target += (target->empty() ? "" : " ") + token;
+        }
+
+        stopSearch();
+
+        if (name == "Hash")
+        {
+            const int mb = std::clamp(std::atoi(value.c_str()), 1, MAX_HASH_MB);
+            m_search.tt().resize(static_cast<std::size_t>(mb));
+        }
+        else if (name == "Threads")
+        {
+            m_search.setThreadCount(std::clamp(std::atoi(value.c_str()), 1, MAX_THREADS));
+        }
+        else if (name == "EvalFile")
+        {
+            if (value.empty() || value == "<empty>")
+            {
+                m_search.setNetwork(nullptr);
+            }
+            else if (m_network.load(value))
+            {
+                m_search.setNetwork(&m_network);
+            }
+            else
+            {
+                m_search.setNetwork(nullptr);
+                send("info string не удалось загрузить сеть: " + value);
+            }
+        }
+        else if (name == "BookFile")
+        {
+            if (value.empty() || value == "<empty>")
+                m_book.close();
+            else if (!m_book.open(value))
+                send("info string не удалось открыть книгу: " + value);
+        }
+        else
+        {
+            send("info string неизвестная опция: " + name);
+        }
+    }
+
+    void Engine::cmdPosition(std::istringstream &in)
+    {
+        stopSearch();
+
+        std::string token;
+        in >> token;
+        m_history.clear();
+
+        if (token == "startpos")
+        {
+            m_board.resetToInitialPosition();
+            in >> token;
+        }
+        else if (token == "fen")
+        {
+            // Поля позиции — до слова moves или до конца строки
+            std::string fen;
+            while (in >> token && token != "moves")
+                fen += (fen.empty() ? "" : " ") + token;
+
+            if (!Fen::parse(fen, m_board))
+            {
+                send("info string неверная позиция: " + fen);
+                m_board.resetToInitialPosition();
+                return;
+            }
+        }
+        else
+        {
+            send("info string ожидается position startpos или position fen");
+            return;
+        }
+
+        if (token != "moves")
+            return;
+
+        while (in >> token)
+        {
+            const PackedMove move = Notation::parseMove(m_board, token);
+            if (move.isNone())
+            {
+                send("info string нелегальный ход: " + token);
+                return;
+            }
+            m_history.push_back(m_board.hash());
+            m_board.makeMove(move);
+        }
+    }
+
+    void Engine::cmdGo(std::istringstream &in)
+    {
+        stopSearch();
+
+        SearchLimits limits;
+        bool infinite = false;
+        long long time[2]   = {-1, -1};   // остаток часов белых и чёрных; -1 — не задан
+        long long inc[2]    = {0, 0};
+        long long movesToGo = 0;
+        std::string token;
+        while (in >> token)
+        {
+            long long value = 0;
+            if (token == "infinite")
+                infinite = true;
+            else if (token == "depth" && in >> value)
+                limits.depth = static_cast<int>(value);
+            else if (token == "movetime" && in >> value)
+                limits.moveTimeMs = value;
+            else if (token == "nodes" && in >> value)
+                limits.nodes = static_cast<std::uint64_t>(value);
+            else if (token == "wtime" && in >> value)
+                time[0] = value;
+            else if (token == "btime" && in >> value)
+                time[1] = value;
+            else if (token == "winc" && in >> value)
+                inc[0] = value;
+            else if (token == "binc" && in >> value)
+                inc[1] = value;
+            else if (token == "movestogo" && in >> value)
+                movesToGo = value;
+        }
+
+        // Часы дают время на ход; до stop ищут только go infinite и go совсем без лимитов
+        const int side = m_board.sideToMove() == PieceColor::White ? 0 : 1;
+        if (!infinite && limits.moveTimeMs == 0 && time[side] >= 0)
+            limits.moveTimeMs = moveBudget(time[side], inc[side], movesToGo);
+
+        if (!infinite && m_book.isOpen())
+        {
+            const PackedMove book = m_book.pick(m_board, m_bookRandom());
+            if (!book.isNone())
+            {
+                send("info string ход из книги");
+                send("bestmove " + Notation::moveToString(book));
+                return;
+            }
+        }
+
+        m_search.setHistory(m_history);
+
+        // Флаги остановки сбрасываются здесь, а не в потоке поиска: stop,
+        // quit или новая команда, пришедшие до его старта, не теряются
+        m_search.prepare();
+
+        const Board board = m_board;
+        m_thread = std::thread([this, board, limits]() {
+            const SearchResult result = m_search.search(board, limits, [this](const SearchResult &r) {
+                reportIteration(r);
+            });
+            send("bestmove " + Notation::moveToString(result.bestMove));
+        });
+    }
+
+    void Engine::stopSearch()
+    {
+        m_search.stop();
+        waitSearch();
+    }
+
+    void Engine::waitSearch()
+    {
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void Engine::reportIteration(const SearchResult &r)
+    {
+        std::string line = "info depth " + std::to_string(r.depth) + " score ";
+        if (isMateScore(r.score))
+        {
+            // Ходы (не полуходы) до мата; отрицательные — мат нам
+            const int plies = r.score > 0 ? SCORE_MATE - r.score : -SCORE_MATE - r.score;
+            line += "mate " + std::to_string(plies > 0 ? (plies + 1) / 2 : (plies - 1) / 2);
+        }
+        else
+        {
+            line += "cp " + std::to_string(r.score);
+        }
+
+        line += " nodes " + std::to_string(r.nodes) +
+                " nps " + std::to_string(r.nps) +
+                " hashfull " + std::to_string(r.hashfull) +
+                " time " + std::to_string(static_cast<long long>(r.seconds * 1000.0)) +
+                " pv";
+        for (PackedMove m : r.pv)
+            line += " " + Notation::moveToString(m);
+
+        send(line);
+    }
+}
+
+int main()
+{
+    Engine engine;
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        if (!engine.handle(line))
+            return 0;
+    }
+
+    // Конец ввода без quit (команды из файла или канала): поиск с
+    // заданными лимитами доводится до конца и печатает bestmove
+    engine.waitSearch();
+    return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <chrono>
+
+// Секунд прошло с момента start (steady_clock): для замеров скорости
+// в инструментах и итогов чтения архивов
+inline double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Файл, отображённый в память только для чтения (mmap / MapViewOfFile).
+ *
+ * Данные читаются прямо со страниц файла, без копирования в буфер:
+ * так грузятся веса сети и бинарные базы. Объект владеет отображением
+ * и снимает его в деструкторе; перемещаемый, но не копируемый.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // Открыть и отобразить файл целиком; false — файла нет или он пуст
+    bool open(const std::string &path);
+    void close() noexcept;
+
+    bool isOpen() const noexcept { return m_data != nullptr; }
+
+    const std::uint8_t *data() const noexcept { return m_data; }
+    std::size_t         size() const noexcept { return m_size; }
+
+private:
+    const std::uint8_t *m_data = nullptr;
+    std::size_t         m_size = 0;
+
+#ifdef _WIN32
+    void *m_file    = nullptr;
+    void *m_mapping = nullptr;
+#endif
+};